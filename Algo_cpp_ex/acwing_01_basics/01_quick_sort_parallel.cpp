@@ -0,0 +1,338 @@
+/*
+ * ============================================
+ *   并行内省排序 (Parallel Introsort) - 快排的工业级进化
+ *   基于 01_quick_sort.cpp 的 quick_sort 模板
+ * ============================================
+ *
+ * 【原版模板的三个软肋】
+ *   1. 单线程：10^8 个数只能用一个核，其余核在围观。
+ *   2. 重复元素：Hoare 划分遇到大量相同值时，相同值会被来回交换，
+ *      而且它们还要继续参与递归，白白浪费时间。
+ *   3. 对抗数据：中间取 pivot 依然能被构造数据卡成 O(N^2)，递归还可能爆栈。
+ *
+ * 【对症下药】
+ *   1. 三数取中 + 按需三路划分 (Dijkstra 荷兰国旗):
+ *        [l, lt)   < x
+ *        [lt, gt] == x   <-- 这一段已经就位，直接"毕业"，不再递归
+ *        (gt, r]   > x
+ *      三个样本里出现相同值才走三路，否则仍用原模板的 Hoare 两路 (交换次数少)。
+ *   2. 深度限制 depth = 2 * log2(n)：超过就改用堆排序兜底，保证 O(N log N)。
+ *   3. 小区间 (<= 16 个数) 交给插入排序：常数极小，缓存友好。
+ *   4. 工作窃取线程池 (Work Stealing)：
+ *        - 每个线程有自己的双端队列 dq[t]。
+ *        - 划分后：一半压进自己队尾，另一半自己接着干。
+ *        - 自己从队尾拿 (LIFO，刚划分出来的数据还在缓存里)；
+ *          闲下来就去别人队头偷 (FIFO，偷到的是最早压入、最大的区间)。
+ *
+ * 【图解：工作窃取】
+ *
+ *   线程0: dq0 = [ [0,5e7) , [5e7,7.5e7) ]   <- 自己在尾部 push/pop
+ *                    ^
+ *                    | 线程1 没活干了，从头部偷走最大的一块
+ *   线程1: dq1 = [ ]
+ *
+ * 【终止条件】
+ *   remaining = 还没"毕业"的元素个数，初始为 n。
+ *   - 三路划分后 == x 的那一段毕业：remaining -= (gt - lt + 1)
+ *   - 小区间串行排完毕业：       remaining -= 区间长度
+ *   remaining 变成 0，说明整个数组排好了，所有线程下班。
+ *
+ * 【复杂度】
+ *   - 时间：最坏 O(N log N) (堆排兜底)，P 个线程下期望 O(N log N / P + N)
+ *           (第一层划分是串行的 O(N)，这是快排并行的天花板)
+ *   - 空间：O(log N) 递归 + 每个线程的任务队列
+ *
+ * 【用法】
+ *   ./a.out            读入 n 和 n 个数 (AcWing 785 格式)，输出排序结果
+ *   ./a.out bench [n] [最大线程数]
+ *                      在 n 个数上对比 std::sort / quick_sort / parallel_sort
+ *   编译: g++ -std=c++17 -O2 -pthread 01_quick_sort_parallel.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+const int INSERTION_LIMIT = 16;  // 小于等于这个长度就用插入排序
+const int PARALLEL_GRAIN = 1 << 14; // 小于这个长度的任务不再拆分，本线程串行做完
+
+// ========== 原版模板 (对照组) ==========
+void quick_sort(int q[], int l, int r) {
+    if (l >= r) return;
+    int x = q[(l + r) >> 1], i = l - 1, j = r + 1;
+    while (i < j) {
+        do i++; while (q[i] < x);
+        do j--; while (q[j] > x);
+        if (i < j) swap(q[i], q[j]);
+    }
+    quick_sort(q, l, j);
+    quick_sort(q, j + 1, r);
+}
+
+// ========== 串行内省排序的三个零件 ==========
+
+// 插入排序：[l, r] 闭区间
+void insertion_sort(int q[], int l, int r) {
+    for (int i = l + 1; i <= r; i++) {
+        int x = q[i], j = i - 1;
+        while (j >= l && q[j] > x) q[j + 1] = q[j], j--;
+        q[j + 1] = x;
+    }
+}
+
+// 堆排序：把 q[l..r] 当成一个下标从 0 开始的大根堆
+// 子节点 2u+1, 2u+2 (这里不能像 10_heap.cpp 那样从 1 开始，因为区间是借来的)
+void sift_down(int a[], int u, int n) {
+    int x = a[u];
+    while (true) {
+        int c = u * 2 + 1;
+        if (c >= n) break;
+        if (c + 1 < n && a[c + 1] > a[c]) c++;
+        if (a[c] <= x) break;
+        a[u] = a[c];
+        u = c;
+    }
+    a[u] = x;
+}
+
+void heap_sort(int q[], int l, int r) {
+    int* a = q + l;
+    int n = r - l + 1;
+    for (int i = n / 2 - 1; i >= 0; i--) sift_down(a, i, n);
+    for (int i = n - 1; i > 0; i--) {
+        swap(a[0], a[i]);
+        sift_down(a, 0, i);
+    }
+}
+
+// 划分：三数取中后选择 Hoare 两路 或 Dijkstra 三路
+// 统一输出 [l, lt) <= x, [lt, gt] == x (已毕业), (gt, r] >= x
+//   - 两路时中间段为空 (lt = gt + 1)，和原模板的 (l, j) (j+1, r) 完全一致
+//   - 三路只在"样本里出现相同值"时才用：随机数据几乎不触发，保住 Hoare 的速度；
+//     重复值多的区间一抽就中，相同值一次性毕业
+void partition(int q[], int l, int r, int& lt, int& gt) {
+    // 三数排序：让 q[l] <= q[mid] <= q[r]，pivot 就是中间那个
+    // pivot 仍然放在 mid 位置，原模板"取中间值不会死循环"的边界证明原样成立
+    int m = (l + r) >> 1;
+    if (q[m] < q[l]) swap(q[m], q[l]);
+    if (q[r] < q[m]) swap(q[r], q[m]);
+    if (q[m] < q[l]) swap(q[m], q[l]);
+    int x = q[m];
+
+    if (q[l] == x || q[r] == x) {
+        int i = l;
+        lt = l, gt = r;
+        while (i <= gt) {
+            if (q[i] < x) swap(q[lt++], q[i++]);
+            else if (q[i] > x) swap(q[i], q[gt--]);
+            else i++;
+        }
+        return;
+    }
+
+    int i = l - 1, j = r + 1;
+    while (i < j) {
+        do i++; while (q[i] < x);
+        do j--; while (q[j] > x);
+        if (i < j) swap(q[i], q[j]);
+    }
+    lt = j + 1, gt = j;
+}
+
+int depth_limit(int n) {
+    int d = 0;
+    while (n > 1) n >>= 1, d++;
+    return d * 2;
+}
+
+// 串行内省排序：对大区间递归，小区间插入排序，太深就堆排序
+// 只递归较小的一边，较大的一边用循环处理，栈深度稳定在 O(log N)
+void introsort(int q[], int l, int r, int depth) {
+    while (r - l + 1 > INSERTION_LIMIT) {
+        if (depth == 0) {
+            heap_sort(q, l, r);
+            return;
+        }
+        depth--;
+        int lt, gt;
+        partition(q, l, r, lt, gt);
+        if (lt - l < r - gt) {
+            introsort(q, l, lt - 1, depth);
+            l = gt + 1;
+        } else {
+            introsort(q, gt + 1, r, depth);
+            r = lt - 1;
+        }
+    }
+    insertion_sort(q, l, r);
+}
+
+// ========== 工作窃取线程池 ==========
+struct Task {
+    int l, r, depth;
+};
+
+struct ParallelSorter {
+    int* q;
+    int threads;
+    vector<deque<Task>> dq; // dq[t]: 线程 t 的任务双端队列
+    vector<mutex> mu;       // mu[t]: 保护 dq[t]
+    atomic<LL> remaining;   // 还没毕业的元素个数
+
+    ParallelSorter(int* q, int n, int threads)
+        : q(q), threads(threads), dq(threads), mu(threads), remaining(n) {}
+
+    void push(int t, Task task) {
+        lock_guard<mutex> lk(mu[t]);
+        dq[t].push_back(task);
+    }
+
+    // 先从自己队尾拿，拿不到就挨个去别人队头偷
+    bool pop_or_steal(int t, Task& task) {
+        {
+            lock_guard<mutex> lk(mu[t]);
+            if (!dq[t].empty()) {
+                task = dq[t].back();
+                dq[t].pop_back();
+                return true;
+            }
+        }
+        for (int k = 1; k < threads; k++) {
+            int v = (t + k) % threads;
+            lock_guard<mutex> lk(mu[v]);
+            if (!dq[v].empty()) {
+                task = dq[v].front();
+                dq[v].pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 处理一个任务：大区间一边拆一边往自己队尾扔，小区间串行收尾
+    void run(int t, Task task) {
+        int l = task.l, r = task.r, depth = task.depth;
+        while (r - l + 1 > PARALLEL_GRAIN && depth > 0) {
+            depth--;
+            int lt, gt;
+            partition(q, l, r, lt, gt);
+            remaining -= gt - lt + 1; // 三路划分时 == x 的一段直接毕业
+            // 较大的一半留给别人偷，自己接着拆较小的一半
+            if (lt - l > r - gt) {
+                if (l < lt) push(t, {l, lt - 1, depth});
+                l = gt + 1;
+            } else {
+                if (gt < r) push(t, {gt + 1, r, depth});
+                r = lt - 1;
+            }
+        }
+        if (l <= r) {
+            introsort(q, l, r, depth);
+            remaining -= r - l + 1;
+        }
+    }
+
+    void worker(int t) {
+        Task task;
+        while (remaining.load() > 0) {
+            if (pop_or_steal(t, task)) run(t, task);
+            else this_thread::yield();
+        }
+    }
+
+    void sort(int n) {
+        if (n <= 0) return;
+        push(0, {0, n - 1, depth_limit(n)});
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(&ParallelSorter::worker, this, t);
+        worker(0); // 主线程也下场干活
+        for (auto& th : pool) th.join();
+    }
+};
+
+// ⚡ 对外接口：threads <= 1 时退化为串行内省排序
+void parallel_sort(int q[], int n, int threads) {
+    if (n <= 1) return;
+    if (threads <= 1) {
+        introsort(q, 0, n - 1, depth_limit(n));
+        return;
+    }
+    ParallelSorter sorter(q, n, threads);
+    sorter.sort(n);
+}
+
+// ========== 基准测试 ==========
+void benchmark(int n, int hw) {
+    mt19937 rng(20260101);
+    // 四种数据：完全随机 / 大量重复 / 已有序 / 全相同
+    const char* names[] = {"random", "dup(0..99)", "sorted", "all-equal"};
+    vector<int> thread_counts = {1};
+    for (int t = 2; t <= hw; t *= 2) thread_counts.push_back(t);
+    if (thread_counts.back() != hw) thread_counts.push_back(hw);
+
+    vector<int> base(n), a(n), ref;
+    for (int kind = 0; kind < 4; kind++) {
+        for (int i = 0; i < n; i++) {
+            if (kind == 0) base[i] = (int)rng();
+            else if (kind == 1) base[i] = rng() % 100;
+            else if (kind == 2) base[i] = i;
+            else base[i] = 7;
+        }
+        cout << "[" << names[kind] << "] n = " << n << endl;
+
+        ref = base;
+        auto st = chrono::steady_clock::now();
+        sort(ref.begin(), ref.end());
+        printf("  %-22s %10.1f ms\n", "std::sort", bench::elapsed_ms(st));
+
+        a = base;
+        st = chrono::steady_clock::now();
+        quick_sort(a.data(), 0, n - 1);
+        printf("  %-22s %10.1f ms\n", "quick_sort (original)", bench::elapsed_ms(st));
+
+        for (int t : thread_counts) {
+            a = base;
+            st = chrono::steady_clock::now();
+            parallel_sort(a.data(), n, t);
+            double ms = bench::elapsed_ms(st);
+            char label[32];
+            snprintf(label, sizeof label, "parallel_sort x%d", t);
+            printf("  %-22s %10.1f ms %s\n", label, ms, bench::check(a == ref));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 10000000;
+        int hw = argc >= 4 ? atoi(argv[3]) : (int)max(1u, thread::hardware_concurrency());
+        benchmark(n, hw);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<int> a(n);
+    for (int i = 0; i < n; i++) cin >> a[i];
+
+    parallel_sort(a.data(), n, max(1u, thread::hardware_concurrency()));
+
+    for (int i = 0; i < n; i++) cout << a[i] << " ";
+    cout << endl;
+    return 0;
+}
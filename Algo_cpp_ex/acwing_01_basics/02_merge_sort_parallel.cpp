@@ -0,0 +1,248 @@
+/*
+ * ============================================
+ *   并行自底向上归并排序 + 逆序对 (Merge Path)
+ *   基于 02_merge_sort.cpp 的 merge_sort 模板
+ *   题目来源: AcWing 787. 归并排序 / AcWing 788. 逆序对的数量
+ * ============================================
+ *
+ * 【原版模板的问题】
+ *   1. 自顶向下递归：10^8 个数要递归 2*10^8 次函数调用。
+ *   2. 每层合并完都要"物归原主"：tmp -> q 多拷贝一遍，访存翻倍。
+ *   3. 单线程：逆序对统计也只能用一个核。
+ *
+ * 【自底向上 + 乒乓缓冲】
+ *   不递归，直接按宽度 width = 1, 2, 4, 8 ... 一轮一轮地合并相邻两段：
+ *
+ *     width=1: [3][1] [2][5] [4]   ->  [1 3] [2 5] [4]
+ *     width=2: [1 3][2 5] [4]      ->  [1 2 3 5] [4]
+ *     width=4: [1 2 3 5][4]        ->  [1 2 3 4 5]
+ *
+ *   两块内存 src / dst 轮流当"读"和"写"：这一轮 src -> dst，下一轮 swap 指针。
+ *   整个排序只在最后 (如果结果恰好落在 tmp 里) 拷回一次。
+ *   第一轮之前先把每 32 个数用插入排序排好，省掉最浅的 5 轮。
+ *
+ * 【Merge Path：把一次合并切给 P 个线程】
+ *   合并 A (长 na) 和 B (长 nb) 时，输出的第 d 个位置 (对角线 d) 一定由
+ *   A 的前 i 个 + B 的前 d-i 个组成，i 可以二分出来：
+ *
+ *            B[0] B[1] B[2] B[3]
+ *     A[0]    .    .    .    .
+ *     A[1]    .    .    .    .        合并过程 = 从左上走到右下的一条路径
+ *     A[2]    .    .    .    .        每条反对角线只和路径交一次
+ *
+ *   于是每一轮把 n 个输出位置平均切成 P 段，每个线程只管自己那段输出：
+ *   - 段里包含的整对 (A, B) 直接合并；
+ *   - 段的两端切在某一对中间时，用 merge path 二分出 (i, j) 的起止点。
+ *   每个线程的工作量严格是 n / P，和数据分布无关。
+ *
+ * 【逆序对怎么并行】
+ *   和原版一样：从 B 里拿走 B[j] 时，A 里还剩下的 na - i 个数都比它大，
+ *   贡献 na - i 个逆序对。切段之后每段各自累加，最后求和即可——
+ *   因为切点就在真实的合并路径上，每个 B[j] 被拿走时看到的 i 和不切时一模一样。
+ *   插入排序阶段每次"往后挪一格"也恰好消除一个逆序对，同样计数。
+ *
+ * 【复杂度】
+ *   - 时间：O(N log N / P + P log N · log N) (后一项是每轮二分切点)
+ *   - 空间：O(N) 一块乒乓缓冲
+ *
+ * 【用法】
+ *   ./a.out                     读入 n 和 n 个数，输出排序结果 (AcWing 787)
+ *   ./a.out inv                 读入 n 和 n 个数，输出逆序对数量 (AcWing 788)
+ *   ./a.out bench [n] [最大线程数]
+ *   编译: g++ -std=c++17 -O2 -pthread 02_merge_sort_parallel.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+const int RUN = 32; // 第一轮之前用插入排序预排的块长
+
+// ========== 原版模板 (对照组)，tmp 改成外部传入以便处理 10^8 ==========
+LL merge_sort(int q[], int tmp[], int l, int r) {
+    if (l >= r) return 0;
+    int mid = (l + r) >> 1;
+    LL res = merge_sort(q, tmp, l, mid) + merge_sort(q, tmp, mid + 1, r);
+    int k = 0, i = l, j = mid + 1;
+    while (i <= mid && j <= r) {
+        if (q[i] <= q[j]) tmp[k++] = q[i++];
+        else tmp[k++] = q[j++], res += mid - i + 1;
+    }
+    while (i <= mid) tmp[k++] = q[i++];
+    while (j <= r) tmp[k++] = q[j++];
+    for (i = l, k = 0; i <= r; i++, k++) q[i] = tmp[k];
+    return res;
+}
+
+// ========== 自底向上的零件 ==========
+
+// 插入排序 [l, r)，返回挪动次数 = 消除的逆序对数
+LL insertion_sort(int q[], int l, int r) {
+    LL res = 0;
+    for (int i = l + 1; i < r; i++) {
+        int x = q[i], j = i - 1;
+        while (j >= l && q[j] > x) q[j + 1] = q[j], j--;
+        res += i - 1 - j;
+        q[j + 1] = x;
+    }
+    return res;
+}
+
+// Merge Path 二分：合并 A[0, na) 和 B[0, nb) 时，输出的前 d 个里有多少个来自 A
+// 相等时 A 优先 (稳定)，所以找最小的 i 使得 A[i] > B[d-i-1]
+int merge_path(const int A[], int na, const int B[], int nb, int d) {
+    int lo = max(0, d - nb), hi = min(d, na);
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (A[mid] <= B[d - mid - 1]) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// 从 (i, j) 开始合并 A、B，一共输出 cnt 个到 out，返回这段产生的逆序对
+LL merge_part(const int A[], int na, const int B[], int nb, int i, int j, int cnt, int out[]) {
+    LL res = 0;
+    for (int k = 0; k < cnt; k++) {
+        if (j >= nb || (i < na && A[i] <= B[j])) out[k] = A[i++];
+        else out[k] = B[j++], res += na - i;
+    }
+    return res;
+}
+
+// 一个线程负责本轮输出位置 [from, to)
+// 这一段可能跨好几对 (A, B)，也可能只是某一对中间的一截
+LL merge_pass_range(const int src[], int dst[], int n, int width, int from, int to) {
+    LL res = 0;
+    int pos = from;
+    while (pos < to) {
+        LL span = 2LL * width;                           // width 可到 2^30，乘 2 用 LL
+        int lo = (int)(pos / span * span);               // 当前这一对的起点
+        int mid = (int)min<LL>((LL)lo + width, n), hi = (int)min<LL>(lo + span, n);
+        int end = min(hi, to);
+        const int* A = src + lo;
+        const int* B = src + mid;
+        int na = mid - lo, nb = hi - mid;
+        int d = pos - lo;
+        int i = merge_path(A, na, B, nb, d);
+        res += merge_part(A, na, B, nb, i, d - i, end - pos, dst + pos);
+        pos = end;
+    }
+    return res;
+}
+
+// ⚡ 对外接口：排序 q[0, n)，返回逆序对数量
+LL merge_sort_parallel(int q[], int n, int threads) {
+    if (n <= 1) return 0;
+    threads = max(1, threads);
+    vector<int> buf(n);
+    vector<LL> part(threads);
+
+    // 第 0 步：每 RUN 个数一块，插入排序 (块之间互不相干，直接按块分给线程)
+    int blocks = (n + RUN - 1) / RUN;
+    auto presort = [&](int t) {
+        LL res = 0;
+        for (int b = (LL)blocks * t / threads; b < (LL)blocks * (t + 1) / threads; b++)
+            res += insertion_sort(q, b * RUN, min(n, (b + 1) * RUN));
+        part[t] = res;
+    };
+
+    auto run = [&](auto&& job) {
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(job, t);
+        job(0);
+        for (auto& th : pool) th.join();
+    };
+
+    LL res = 0;
+    run(presort);
+    for (LL x : part) res += x;
+
+    // 之后每一轮：src -> dst，按输出位置均分给线程，轮末交换指针
+    int* src = q;
+    int* dst = buf.data();
+    for (int width = RUN; width < n; width *= 2) {
+        auto pass = [&](int t) {
+            int from = (LL)n * t / threads, to = (LL)n * (t + 1) / threads;
+            part[t] = merge_pass_range(src, dst, n, width, from, to);
+        };
+        if (threads == 1) part[0] = merge_pass_range(src, dst, n, width, 0, n);
+        else run(pass);
+        for (LL x : part) res += x;
+        fill(part.begin(), part.end(), 0);
+        swap(src, dst);
+        if (width > n / 2) break; // 防止 width * 2 溢出 int
+    }
+
+    // 结果落在 buf 里就拷回去 (整个排序只拷这一次)
+    if (src != q) memcpy(q, src, sizeof(int) * n);
+    return res;
+}
+
+// ========== 基准测试 ==========
+void benchmark(int n, int hw) {
+    mt19937 rng(20260102);
+    vector<int> base(n), a, tmp(n), ref;
+    for (int i = 0; i < n; i++) base[i] = (int)rng();
+
+    vector<int> thread_counts = {1};
+    for (int t = 2; t <= hw; t *= 2) thread_counts.push_back(t);
+    if (thread_counts.back() != hw) thread_counts.push_back(hw);
+
+    cout << "[random] n = " << n << endl;
+    ref = base;
+    auto st = chrono::steady_clock::now();
+    stable_sort(ref.begin(), ref.end());
+    printf("  %-26s %10.1f ms\n", "std::stable_sort", bench::elapsed_ms(st));
+
+    a = base;
+    st = chrono::steady_clock::now();
+    LL expect = merge_sort(a.data(), tmp.data(), 0, n - 1);
+    printf("  %-26s %10.1f ms  inv = %lld\n", "merge_sort (original)", bench::elapsed_ms(st), expect);
+
+    for (int t : thread_counts) {
+        a = base;
+        st = chrono::steady_clock::now();
+        LL inv = merge_sort_parallel(a.data(), n, t);
+        double ms = bench::elapsed_ms(st);
+        char label[40];
+        snprintf(label, sizeof label, "merge_sort_parallel x%d", t);
+        printf("  %-26s %10.1f ms  inv = %lld%s\n", label, ms, inv, bench::check(a == ref && inv == expect));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 10000000;
+        int hw = argc >= 4 ? atoi(argv[3]) : (int)max(1u, thread::hardware_concurrency());
+        benchmark(n, hw);
+        return 0;
+    }
+    bool count_inv = argc >= 2 && strcmp(argv[1], "inv") == 0;
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<int> a(n);
+    for (int i = 0; i < n; i++) cin >> a[i];
+
+    LL inv = merge_sort_parallel(a.data(), n, max(1u, thread::hardware_concurrency()));
+
+    if (count_inv) cout << inv << endl;
+    else {
+        for (int i = 0; i < n; i++) cout << a[i] << " ";
+        cout << endl;
+    }
+    return 0;
+}
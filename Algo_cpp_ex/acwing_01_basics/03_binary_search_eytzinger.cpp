@@ -0,0 +1,252 @@
+/*
+ * ============================================
+ *   缓存友好的二分 - Eytzinger 布局 + 无分支下降 + 批量查询
+ *   基于 03_binary_search.cpp / basics_08_binary_search_dongxiao.cpp
+ *   题目来源: AcWing 789. 数的范围
+ * ============================================
+ *
+ * 【普通二分慢在哪】
+ *   二分本身只有 log N 步，但在 10^9 个数的有序数组上：
+ *   - 前几步访问的 q[n/2], q[n/4], q[3n/4] ... 彼此相隔几百 MB，每一步都是一次缓存未命中；
+ *   - if (q[mid] < x) 这个分支 50% 概率跳哪边，CPU 分支预测完全失效；
+ *   - 下一步要读哪里，取决于这一步读回来的值，内存延迟一步步串行叠加。
+ *
+ * 【Eytzinger 布局：把有序数组改成"堆的样子"】
+ *   和 10_heap.cpp 一样下标从 1 开始：k 的左孩子 2k，右孩子 2k+1。
+ *   对这棵完全二叉树做中序遍历，依次填入有序数组的元素：
+ *
+ *     有序数组:  [1 2 3 4 5 6 7]
+ *
+ *                   b[1]=4
+ *                 /        \
+ *             b[2]=2      b[3]=6
+ *             /   \        /   \
+ *          b[4]=1 b[5]=3 b[6]=5 b[7]=7
+ *
+ *     Eytzinger:  b = [_, 4, 2, 6, 1, 3, 5, 7]
+ *
+ *   二分 = 从根往下走：b[k] < x 往右 (2k+1)，否则往左 (2k)。
+ *   好处：越靠近根的点越常被访问，它们全挤在数组最前面，常驻缓存。
+ *
+ * 【无分支 + 预取】
+ *   k = 2 * k + (b[k] < x);          // 比较结果直接当 0/1 用，没有 if
+ *   __builtin_prefetch(b + k * 16);  // 16 个 int = 一条 64 字节缓存行
+ *   k 往下 4 层的 16 个后代 16k ... 16k+15 恰好连续，并且 b 按 64 字节对齐时落在同一缓存行。
+ *   提前 4 层把它们拉进缓存，等走到那一层时数据已经在路上了。
+ *
+ * 【走完之后怎么还原答案】
+ *   往左走在 k 的二进制末尾追加 0，往右走追加 1。
+ *   答案是"最后一次往左走"的那个点，即去掉末尾所有的 1 和它前面那个 0：
+ *     k >>= __builtin_ffsll(~k);
+ *   k == 0 说明一次都没往左走 (所有数都 < x)，答案是 n。
+ *   rank[k] 记录 b[k] 在原数组里的下标，保证返回值和 std::lower_bound 完全一致。
+ *
+ * 【批量查询：让内存延迟重叠】
+ *   单次查询的每一步都依赖上一步，CPU 只能干等内存。
+ *   一次拿 16 个查询，按"层"轮流往下走一步：16 个互相独立的访存同时在路上，
+ *   总耗时接近"一个查询的延迟"而不是"16 个查询的延迟之和"。
+ *   为了让 16 个查询步调一致，先走满 h = floor(log2(n+1)) 层 (这些层一定是满的，不会越界)，
+ *   最后再补一步 (只有部分叶子在第 h+1 层)。
+ *
+ * 【复杂度】
+ *   - 建索引：O(N)，额外空间 N 个键 + N 个 uint32 下标 (n < 2^32)
+ *   - 查询：O(log N)，缓存未命中约 log N / 4 次 (每 4 层一次)
+ *
+ * 【用法】
+ *   ./a.out                      AcWing 789：读入 n q、数组、q 个询问，输出起止位置
+ *   ./a.out bench [n] [查询数]
+ *   编译: g++ -std=c++17 -O2 03_binary_search_eytzinger.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+template <class T>
+struct EytzingerIndex {
+    static const int BATCH = 16;            // 批量查询一组的大小
+    static const int LINE = 64 / sizeof(T); // 一条缓存行放几个键
+
+    LL n = 0;
+    int h = 0;            // 满层数 floor(log2(n+1))
+    vector<T> storage;    // b 的真实内存 (多开一点用来对齐)
+    T* b = nullptr;       // b[1..n]：Eytzinger 顺序的键，b 按 64 字节对齐
+    vector<uint32_t> rank; // rank[k]：b[k] 在原有序数组里的下标
+
+    EytzingerIndex() {}
+    EytzingerIndex(const T* a, LL n) { build(a, n); }
+
+    void build(const T* a, LL n_) {
+        n = n_;
+        storage.assign(n + 1 + LINE, T());
+        uintptr_t p = (uintptr_t)storage.data();
+        b = (T*)((p + 63) / 64 * 64);
+        rank.assign(n + 1, 0);
+        h = 0;
+        while ((1LL << (h + 1)) - 1 <= n) h++;
+
+        // 中序遍历填数：用显式栈代替递归 (沿左链下探，回溯时填数，再转向右孩子)
+        LL i = 0, k = 1;
+        vector<LL> stk;
+        while (k <= n || !stk.empty()) {
+            while (k <= n) stk.push_back(k), k = 2 * k;
+            k = stk.back();
+            stk.pop_back();
+            b[k] = a[i];
+            rank[k] = (uint32_t)i++;
+            k = 2 * k + 1;
+        }
+    }
+
+    // 叶子之后还原：去掉末尾的 1 和一个 0，得到"最后一次往左走"的点
+    LL finish(LL k) const {
+        k >>= __builtin_ffsll(~k);
+        return k ? rank[k] : n;
+    }
+
+    // 单次查询：UPPER = false 是 lower_bound (第一个 >= x)，true 是 upper_bound (第一个 > x)
+    template <bool UPPER>
+    LL search(T x) const {
+        LL k = 1;
+        while (k <= n) {
+            __builtin_prefetch(b + k * LINE);
+            k = 2 * k + (UPPER ? !(x < b[k]) : (b[k] < x));
+        }
+        return finish(k);
+    }
+
+    LL lower_bound(T x) const { return search<false>(x); }
+    LL upper_bound(T x) const { return search<true>(x); }
+
+    // 批量查询：每 BATCH 个查询一组，逐层轮流下降
+    template <bool UPPER>
+    void search_batch(const T* xs, LL m, LL* out) const {
+        for (LL s = 0; s < m; s += BATCH) {
+            int g = (int)min<LL>(BATCH, m - s);
+            LL k[BATCH];
+            for (int j = 0; j < g; j++) k[j] = 1;
+            for (int lv = 0; lv < h; lv++) {
+                for (int j = 0; j < g; j++) {
+                    __builtin_prefetch(b + k[j] * LINE);
+                    T x = xs[s + j];
+                    k[j] = 2 * k[j] + (UPPER ? !(x < b[k[j]]) : (b[k[j]] < x));
+                }
+            }
+            for (int j = 0; j < g; j++) {
+                T x = xs[s + j];
+                if (k[j] <= n) k[j] = 2 * k[j] + (UPPER ? !(x < b[k[j]]) : (b[k[j]] < x));
+                out[s + j] = finish(k[j]);
+            }
+        }
+    }
+
+    void lower_bound_batch(const T* xs, LL m, LL* out) const { search_batch<false>(xs, m, out); }
+    void upper_bound_batch(const T* xs, LL m, LL* out) const { search_batch<true>(xs, m, out); }
+
+    // basics_08 的两个接口：找不到 x 返回 -1
+    // a 是建索引用的原有序数组 (只用来核对 a[r] == x，也可以用 b 反查，但原数组通常就在手边)
+    LL find_first_ge(const T* a, T x) const {
+        LL r = lower_bound(x);
+        return (r == n || a[r] != x) ? -1 : r;
+    }
+    LL find_last_le(const T* a, T x) const {
+        LL l = upper_bound(x) - 1;
+        return (l < 0 || a[l] != x) ? -1 : l;
+    }
+};
+
+// ========== 基准测试 ==========
+// basics_08 的写法 (对照组)：开区间 (-1, n) 的蓝红二分
+LL classic_lower_bound(const int q[], LL n, int x) {
+    LL l = -1, r = n;
+    while (l + 1 != r) {
+        LL mid = (l + r) / 2;
+        if (q[mid] < x) l = mid;
+        else r = mid;
+    }
+    return r;
+}
+
+void benchmark(LL n, LL m) {
+    mt19937 rng(20260104);
+    vector<int> a(n), xs(m);
+    for (auto& x : a) x = (int)(rng() >> 1);
+    sort(a.begin(), a.end());
+    for (auto& x : xs) x = (int)(rng() >> 1);
+
+    auto st = chrono::steady_clock::now();
+    EytzingerIndex<int> idx(a.data(), n);
+    printf("n = %lld, queries = %lld, build %.1f ms\n", n, m, bench::elapsed_ms(st));
+
+    vector<LL> ref(m), got(m);
+    LL sum = 0;
+    st = chrono::steady_clock::now();
+    for (LL i = 0; i < m; i++) ref[i] = std::lower_bound(a.begin(), a.end(), xs[i]) - a.begin();
+    double t_std = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    for (LL i = 0; i < m; i++) sum += classic_lower_bound(a.data(), n, xs[i]);
+    double t_classic = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    for (LL i = 0; i < m; i++) got[i] = idx.lower_bound(xs[i]);
+    double t_single = bench::elapsed_ms(st);
+    bool ok = got == ref;
+
+    st = chrono::steady_clock::now();
+    idx.lower_bound_batch(xs.data(), m, got.data());
+    double t_batch = bench::elapsed_ms(st);
+    ok = ok && got == ref;
+
+    // upper_bound 也核对一遍
+    idx.upper_bound_batch(xs.data(), m, got.data());
+    for (LL i = 0; i < m && ok; i++)
+        ok = got[i] == std::upper_bound(a.begin(), a.end(), xs[i]) - a.begin();
+
+    auto report = [&](const char* name, double ms) {
+        printf("  %-24s %9.1f ms  %7.2f M queries/s\n", name, ms, m / ms / 1000);
+    };
+    report("std::lower_bound", t_std);
+    report("classic (-1, n) search", t_classic);
+    report("eytzinger single", t_single);
+    report("eytzinger batch x16", t_batch);
+    printf("  results %s (checksum %lld)\n", ok ? "identical" : "MISMATCH!", sum);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        LL n = argc >= 3 ? atoll(argv[2]) : 10000000;
+        LL m = argc >= 4 ? atoll(argv[3]) : 10000000;
+        benchmark(n, m);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 789: 输入 6 3 / 1 2 2 3 3 4 / 3 4 5，输出 3 4 / 5 5 / -1 -1
+    int n, q;
+    if (!(cin >> n >> q)) return 0;
+    vector<int> a(n), xs(q);
+    for (int i = 0; i < n; i++) cin >> a[i];
+    for (int i = 0; i < q; i++) cin >> xs[i];
+
+    EytzingerIndex<int> idx(a.data(), n);
+    vector<LL> lo(q), hi(q);
+    idx.lower_bound_batch(xs.data(), q, lo.data());
+    idx.upper_bound_batch(xs.data(), q, hi.data());
+    for (int i = 0; i < q; i++) {
+        if (lo[i] == n || a[lo[i]] != xs[i]) cout << "-1 -1\n";
+        else cout << lo[i] << " " << hi[i] - 1 << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+ * ============================================
+ *   批量浮点二分 - 有序整数表示 + SIMD 车道 + Newton 收尾
+ *   基于 04_float_binary_search.cpp / basics_09_float_binary_dongxiao.cpp
+ *   题目来源: AcWing 790. 数的三次方根
+ * ============================================
+ *
+ * 【原版慢在哪】
+ *   while (r - l > 1e-8) 在 [-10000, 10000] 上要 41 步，一次只算一个数；
+ *   每一步的 mid 依赖上一步的比较结果，CPU 大部分时间在等乘法和比较的延迟。
+ *   而且 1e-8 是绝对精度：答案很大时 r - l 到不了 1e-8 (相邻 double 的间距都比它大) 会死循环，
+ *   答案很小时 1e-8 又远远不够。
+ *
+ * 【在 double 的"序号"上二分】
+ *   非负 double 的位模式按无符号整数比较，和按数值比较顺序一致；负数反过来。
+ *   于是做一个保序映射 (和 23_radix_sort 给 int 翻符号位是同一个思路)：
+ *
+ *     非负数: key = bits ^ 0x8000...      (符号位翻成 1，排在所有负数后面)
+ *     负数:   key = ~bits                  (整体取反，绝对值越大 key 越小)
+ *
+ *     -inf ... -1.0 ... -0.0 | +0.0 ... 1.0 ... +inf     数值顺序
+ *      0x000F..  0x403F..  0x7FFF.. | 0x8000.. 0xBFF0.. 0xFFF0..  key 顺序一致
+ *
+ *   相邻的 key 就是相邻的 double。在 key 上做整数二分 (第一个 f(t) >= y 的 t)，
+ *   区间长度每步减半，最多 64 步后恰好剩一个数：
+ *   结果是"最小的满足 f(t) >= y 的 double"，精确到最后一位，和数值大小无关，不会死循环。
+ *
+ * 【车道：一次推进 8 个输入】
+ *   区间长度只和 [lo, hi] 有关，同一批输入走的步数完全相同，所以 8 个输入可以齐步走：
+ *     len = 区间里 key 的个数
+ *     while (len > 1):
+ *         half = len / 2
+ *         每条车道: base = f(base + half - 1) >= y ? base : base + half   (无分支选择)
+ *         len -= half
+ *   用 GCC 向量扩展写成 8 x double，f 写成泛型 lambda，标量和向量都能调用：
+ *     auto cube = [](const auto& t) { return t * t * t; };
+ *   不开 AVX 时编译器拆成几条 SSE 指令，开 -march=native 就是 AVX2 / AVX-512；
+ *   即使拆开，8 条互不依赖的计算链也能让乘法延迟互相重叠。
+ *
+ * 【Newton 收尾 (可选)】
+ *   key 二分前十几步先定下符号和指数 (数量级)，之后每步只多一位尾数，要 52 步左右。
+ *   Newton 法每步有效位数翻倍，所以：
+ *   1. 车道二分先走 coarse 步 (默认 16，相对误差 ~1/16)；
+ *   2. 车道内做 iters 步保护式 Newton：t -= (f(t) - y) / f'(t)，
+ *      每步顺便用 f(t) >= y 收紧区间，迭代点跑出区间就退回区间中点；
+ *   3. 逐条车道收尾：从 Newton 的结果往两边按 1, 2, 4 ... 个 ulp 倍增试探，
+ *      夹出一个小区间再二分到底。
+ *   第 3 步只用到 f 的单调性，所以结果和纯二分逐位相同 (Newton 只负责把起点放到答案旁边)。
+ *
+ * 【复杂度】
+ *   - 纯二分：每个输入 ceil(log2 区间 key 数) <= 64 次 f，8 个一组并行
+ *   - Newton：coarse + iters 次 (f, f') + 收尾 O(log 误差 ulp 数) 次 f
+ *   - 要求 f 在 [lo, hi] 上单调不减；找不到满足的 t 时返回 hi (和原版 r 的极限一致)
+ *
+ * 【用法】
+ *   ./a.out                 AcWing 790：读入 x，输出三次方根 (6 位小数)
+ *   ./a.out batch           读入 n 和 n 个 x，每行输出一个三次方根
+ *   ./a.out bench [n]
+ *   编译: g++ -std=c++17 -O2 -march=native 04_float_binary_search_batch.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// 64 字节的向量当返回值，没开 AVX-512 时 GCC 会提示 ABI 变化；这里全是 inline 函数，不跨编译单元
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+const int LANES = 8;
+typedef double vd __attribute__((vector_size(LANES * sizeof(double))));
+typedef uint64_t vu __attribute__((vector_size(LANES * sizeof(uint64_t))));
+typedef int64_t vi __attribute__((vector_size(LANES * sizeof(int64_t))));
+
+const uint64_t SIGN = 1ull << 63;
+
+// ========== double <-> 保序 key ==========
+inline uint64_t to_key(double x) {
+    uint64_t u;
+    memcpy(&u, &x, sizeof u);
+    return u ^ ((uint64_t)((int64_t)u >> 63) | SIGN); // 负数全取反，非负数只翻符号位
+}
+inline double from_key(uint64_t k) {
+    uint64_t u = k ^ (~(uint64_t)((int64_t)k >> 63) | SIGN);
+    double x;
+    memcpy(&x, &u, sizeof x);
+    return x;
+}
+inline vu to_key(const vd& x) {
+    vu u = (vu)x;
+    return u ^ ((vu)((vi)u >> 63) | SIGN);
+}
+inline vd from_key(const vu& k) { return (vd)(k ^ (~(vu)((vi)k >> 63) | SIGN)); }
+
+// m 的每条车道是全 1 或全 0：全 1 取 a，否则取 b
+inline vu pick(const vu& m, const vu& a, const vu& b) { return (m & a) | (~m & b); }
+
+// ========== 标量：key 区间 [L, R] 里第一个 f >= y 的 (R 当作一定满足) ==========
+template <class F>
+uint64_t first_true(F& f, double y, uint64_t L, uint64_t R) {
+    while (L < R) {
+        uint64_t M = L + (R - L) / 2;
+        if (f(from_key(M)) >= y) R = M;
+        else L = M + 1;
+    }
+    return L;
+}
+
+// 已知答案在 [L, R]、近似解 t：从 t 往两边倍增试探，夹出小区间再二分
+template <class F>
+uint64_t polish(F& f, double y, uint64_t L, uint64_t R, double t) {
+    uint64_t k = min(max(to_key(t), L), R);
+    if (f(from_key(k)) >= y) {
+        R = k;
+        for (uint64_t d = 1; k - L > d; d *= 2) {
+            if (f(from_key(k - d)) < y) {
+                L = k - d + 1;
+                break;
+            }
+            R = k - d;
+        }
+    } else {
+        L = k + 1;
+        for (uint64_t d = 1; R - k > d; d *= 2) {
+            if (f(from_key(k + d)) >= y) {
+                R = k + d;
+                break;
+            }
+            L = k + d + 1;
+        }
+    }
+    return first_true(f, y, min(L, R), R);
+}
+
+// ========== 批量求解 ==========
+
+// 读入一组 LANES 个 y (不足的用最后一个补齐)
+inline vd load_lanes(const double* y, int cnt) {
+    vd Y;
+    for (int j = 0; j < LANES; j++) Y[j] = y[min(j, cnt - 1)];
+    return Y;
+}
+
+// ⚡ 纯二分：out[i] = [lo, hi] 里最小的满足 f(t) >= y[i] 的 double
+template <class F>
+void bisect_batch(F f, const double* y, double* out, int n, double lo, double hi) {
+    uint64_t K0 = to_key(lo), K1 = to_key(hi);
+    for (int i = 0; i < n; i += LANES) {
+        int cnt = min(LANES, n - i);
+        vd Y = load_lanes(y + i, cnt);
+        vu B = (vu){} + K0;
+        for (uint64_t len = K1 - K0 + 1; len > 1;) {
+            uint64_t half = len / 2;
+            vu p = (vu)(f(from_key(B + (half - 1))) >= Y);
+            B = pick(p, B, B + half);
+            len -= half;
+        }
+        vd t = from_key(B);
+        for (int j = 0; j < cnt; j++) out[i + j] = t[j];
+    }
+}
+
+// ⚡ 二分定数量级 + Newton + 逐位收尾，结果和 bisect_batch 完全相同；df 是 f 的导数
+template <class F, class DF>
+void newton_batch(F f, DF df, const double* y, double* out, int n, double lo, double hi, int coarse = 16,
+                  int iters = 4) {
+    uint64_t K0 = to_key(lo), K1 = to_key(hi);
+    for (int i = 0; i < n; i += LANES) {
+        int cnt = min(LANES, n - i);
+        vd Y = load_lanes(y + i, cnt);
+
+        // 1. 车道二分 coarse 步，答案在 [B, B + len)
+        vu B = (vu){} + K0;
+        uint64_t len = K1 - K0 + 1;
+        for (int s = 0; s < coarse && len > 1; s++) {
+            uint64_t half = len / 2;
+            vu p = (vu)(f(from_key(B + (half - 1))) >= Y);
+            B = pick(p, B, B + half);
+            len -= half;
+        }
+
+        // 2. 保护式 Newton，各车道的区间 [L, R] 从这里开始各走各的
+        vu L = B, R = B + (len - 1);
+        vd t = from_key(L + ((R - L) >> 1));
+        for (int s = 0; s < iters; s++) {
+            vd v = f(t);
+            vu k = to_key(t), p = (vu)(v >= Y);
+            R = pick(p, k, R);
+            L = pick(p, L, k + 1);
+            L = pick((vu)(L > R), R, L); // k 是不满足的 hi 端点时 k + 1 会越过 R
+            vd nt = t - (v - Y) / df(t);
+            vu ok = (vu)((nt >= from_key(L)) & (nt <= from_key(R))); // NaN / 跑出区间都不接受
+            t = (vd)pick(ok, (vu)nt, (vu)from_key(L + ((R - L) >> 1)));
+        }
+
+        // 3. 逐条车道精确收尾
+        for (int j = 0; j < cnt; j++) out[i + j] = from_key(polish(f, y[i + j], L[j], R[j], t[j]));
+    }
+}
+
+// ========== 基准测试 ==========
+// 原版 (对照组)：一个一个地 while (r - l > 1e-8)
+double cube_root_original(double x) {
+    double l = -10000, r = 10000;
+    while (r - l > 1e-8) {
+        double mid = (l + r) / 2;
+        if (mid * mid * mid >= x) r = mid;
+        else l = mid;
+    }
+    return l;
+}
+
+void benchmark(int n) {
+    mt19937_64 rng(20260115);
+    uniform_real_distribution<double> dist(-10000, 10000);
+    vector<double> y(n), ref(n), a(n), b(n);
+    for (auto& v : y) {
+        double r = dist(rng);
+        v = r * r * r;
+    }
+    auto cube = [](const auto& t) { return t * t * t; };
+    auto dcube = [](const auto& t) { return 3 * t * t; };
+    printf("%d cube roots on [-10000, 10000]\n", n);
+
+    auto st = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) ref[i] = cube_root_original(y[i]);
+    double t_orig = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    bisect_batch(cube, y.data(), a.data(), n, -10000, 10000);
+    double t_bis = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    newton_batch(cube, dcube, y.data(), b.data(), n, -10000, 10000);
+    double t_newton = bench::elapsed_ms(st);
+
+    // 原版的 l 满足 l^3 < x <= r^3 且 r - l <= 1e-8，精确答案一定落在 (l, l + 1e-8]
+    bool ok1 = true;
+    for (int i = 0; i < n; i++) ok1 &= a[i] > ref[i] && a[i] - ref[i] <= 1e-8;
+    bool ok2 = a == b;
+
+    printf("  %-34s %9.1f ms  (%.1f ns / value)\n", "original, while (r - l > 1e-8)", t_orig, t_orig * 1e6 / n);
+    printf("  %-34s %9.1f ms  (%.1f ns / value)%s\n", "key bisection, 8 lanes", t_bis, t_bis * 1e6 / n,
+           bench::check(ok1));
+    printf("  %-34s %9.1f ms  (%.1f ns / value)%s\n", "key bisection + Newton polish", t_newton, t_newton * 1e6 / n,
+           bench::check(ok2));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        benchmark(argc >= 3 ? atoi(argv[2]) : 4000000);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+    auto cube = [](const auto& t) { return t * t * t; };
+    auto dcube = [](const auto& t) { return 3 * t * t; };
+
+    if (argc >= 2 && strcmp(argv[1], "batch") == 0) {
+        int n;
+        if (!(cin >> n)) return 0;
+        vector<double> y(n), out(n);
+        for (auto& v : y) cin >> v;
+        newton_batch(cube, dcube, y.data(), out.data(), n, -10000, 10000);
+        for (double v : out) cout << fixed << setprecision(6) << v << "\n";
+        return 0;
+    }
+
+    // AcWing 790: 输入 1000.00，输出 10.000000
+    double x;
+    if (!(cin >> x)) return 0;
+    double out;
+    bisect_batch(cube, &x, &out, 1, -10000, 10000);
+    cout << fixed << setprecision(6) << out << endl;
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * ============================================
+ *   动态二维区间和 - 二维树状数组 (区间加 + 区间求和)
+ *   基于 10_prefix_sum_2d.cpp (二维前缀和) + 13_difference_2d.cpp (二维差分)
+ * ============================================
+ *
+ * 【原版的局限】
+ *   - 二维前缀和：建一次表，之后只能查，不能改；
+ *   - 二维差分：  可以 O(1) 改子矩阵，但想查和必须 O(nm) 重新求一遍前缀和。
+ *   热力图场景是"加一块 -> 查一块 -> 再加一块"交替进行，每次查询都重建就是 O(nm) 一次。
+ *
+ * 【思路：差分 + 树状数组】
+ *   还是 13_difference_2d 的差分矩阵 D (a 是 D 的二维前缀和)，子矩阵加 c 只改 D 的 4 个角：
+ *     D[x1][y1] += c, D[x1][y2+1] -= c, D[x2+1][y1] -= c, D[x2+1][y2+1] += c
+ *   而 a 的二维前缀和 S(x, y) = Σ_{i<=x, j<=y} a[i][j] 可以展开成 (每个 D[i][j] 被数了 (x-i+1)(y-j+1) 次)：
+ *     S(x, y) = (x+1)(y+1) ΣD - (y+1) Σ(D*i) - (x+1) Σ(D*j) + Σ(D*i*j)
+ *   所以维护 4 棵二维树状数组：D, D*i, D*j, D*i*j，改和查都是 O(log n * log m)。
+ *
+ * 【缓存友好的布局】
+ *   1. 4 个计数器打包成一个 32 字节的向量 v4 = {D, D*i, D*j, D*i*j}：
+ *      一次更新 / 查询访问一个格子只碰一条缓存行，而且 4 个数一条 SIMD 指令就加完。
+ *   2. 按 8x8 分块存储 (tile)：格子 (x, y) 在第 (x/8, y/8) 块里。
+ *      树状数组的前几跳 (lowbit 很小) x、y 都只变化一点点，落在同一块 (2KB) 里，
+ *      行主序时 x -> x+1 要跨过整整一行 (4096 * 32B = 128KB)。
+ *
+ * 【O(nm) 批量建树 (SIMD)】
+ *   逐个格子 add 是 O(nm log n log m)。线性建树：
+ *   1. 先算差分 D，直接填入 v4 {D, D*i, D*j, D*i*j}；
+ *   2. 行内：t[i][j + lowbit(j)] += t[i][j]   (每行一遍)
+ *   3. 行间：第 i + lowbit(i) 行 += 第 i 行   (整行相加，每格一条 v4 加法，分块内连续 8 格)
+ *   和一维树状数组 "把自己加到父亲身上" 的线性建树是同一个道理，只是做两遍。
+ *
+ * 【复杂度】
+ *   - 建树：O(nm)
+ *   - 子矩阵加 / 子矩阵求和：O(log n * log m)
+ *   - 空间：(n+8)(m+8) 个 32 字节格子 (4096x4096 约 540MB)
+ *
+ * 【用法】
+ *   ./a.out   读入 n m q、n 行 m 列矩阵、q 个操作：
+ *             1 x1 y1 x2 y2 c  子矩阵加 c；  2 x1 y1 x2 y2  输出子矩阵和
+ *   ./a.out bench [边长] [操作数]
+ *   编译: g++ -std=c++17 -O2 10_prefix_sum_2d_fenwick.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef LL v4 __attribute__((vector_size(32))); // GCC/Clang 向量扩展：4 个 LL 一起加
+
+struct Fenwick2D {
+    static const int TILE = 8; // 8x8 分块
+
+    int n = 0, m = 0, tiles_per_row = 0;
+    vector<v4> t;
+
+    // (x, y) -> 分块布局下的下标 (x, y 从 1 开始)
+    int id(int x, int y) const {
+        return ((x >> 3) * tiles_per_row + (y >> 3)) * (TILE * TILE) + (x & 7) * TILE + (y & 7);
+    }
+
+    void init(int n_, int m_) {
+        n = n_, m = m_;
+        tiles_per_row = m / TILE + 1;
+        t.assign((size_t)(n / TILE + 1) * tiles_per_row * TILE * TILE, v4{0, 0, 0, 0});
+    }
+
+    // 差分矩阵 D[x][y] += d
+    void add_point(int x, int y, LL d) {
+        v4 w = {d, d * x, d * y, d * x * y};
+        for (int i = x; i <= n; i += i & -i)
+            for (int j = y; j <= m; j += j & -j) t[id(i, j)] += w;
+    }
+
+    // S(x, y) = 左上角 (1, 1) 到 (x, y) 的和
+    LL prefix(int x, int y) const {
+        v4 s = {0, 0, 0, 0};
+        for (int i = x; i > 0; i -= i & -i)
+            for (int j = y; j > 0; j -= j & -j) s += t[id(i, j)];
+        return (LL)(x + 1) * (y + 1) * s[0] - (LL)(y + 1) * s[1] - (LL)(x + 1) * s[2] + s[3];
+    }
+
+    // 子矩阵 (x1, y1) ~ (x2, y2) 每个数加 c：差分的 4 个角
+    void range_add(int x1, int y1, int x2, int y2, LL c) {
+        add_point(x1, y1, c);
+        add_point(x1, y2 + 1, -c);
+        add_point(x2 + 1, y1, -c);
+        add_point(x2 + 1, y2 + 1, c);
+    }
+
+    // 子矩阵求和：10_prefix_sum_2d 的容斥公式
+    LL range_sum(int x1, int y1, int x2, int y2) const {
+        return prefix(x2, y2) - prefix(x1 - 1, y2) - prefix(x2, y1 - 1) + prefix(x1 - 1, y1 - 1);
+    }
+
+    // O(nm) 批量建树：a 是 n 行 m 列、下标从 0 开始、行跨度为 stride 的矩阵
+    void build(const int* a, int n_, int m_, int stride) {
+        init(n_, m_);
+        auto A = [&](int i, int j) -> LL { return (i && j) ? a[(size_t)(i - 1) * stride + (j - 1)] : 0; };
+
+        // 1. 差分 D[i][j] = a[i][j] - a[i-1][j] - a[i][j-1] + a[i-1][j-1]
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) {
+                LL d = A(i, j) - A(i - 1, j) - A(i, j - 1) + A(i - 1, j - 1);
+                t[id(i, j)] = v4{d, d * i, d * j, d * i * j};
+            }
+
+        // 2. 行内：把自己加到父亲 j + lowbit(j) 上
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) {
+                int p = j + (j & -j);
+                if (p <= m) t[id(i, p)] += t[id(i, j)];
+            }
+
+        // 3. 行间：第 i 行整行加到第 i + lowbit(i) 行，每格一条向量加法
+        for (int i = 1; i <= n; i++) {
+            int p = i + (i & -i);
+            if (p > n) continue;
+            for (int j = 1; j <= m; j++) t[id(p, j)] += t[id(i, j)];
+        }
+    }
+};
+
+// ========== 基准测试 ==========
+struct Op {
+    int type, x1, y1, x2, y2, c;
+};
+
+// 对照组：13_difference_2d 的差分 + 查询前重建一遍 10_prefix_sum_2d 的前缀和表
+struct RebuildTable {
+    int n, m;
+    vector<LL> b, s; // (n+2) x (m+2)
+
+    int at(int i, int j) const { return i * (m + 2) + j; }
+
+    void build(const int* a, int n_, int m_) {
+        n = n_, m = m_;
+        b.assign((size_t)(n + 2) * (m + 2), 0);
+        s.assign(b.size(), 0);
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) insert(i, j, i, j, a[(size_t)(i - 1) * m + (j - 1)]);
+    }
+    void insert(int x1, int y1, int x2, int y2, LL c) {
+        b[at(x1, y1)] += c, b[at(x2 + 1, y1)] -= c, b[at(x1, y2 + 1)] -= c, b[at(x2 + 1, y2 + 1)] += c;
+    }
+    // 差分 -> 原矩阵 -> 前缀和，两遍 O(nm)
+    void rebuild() {
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) s[at(i, j)] = b[at(i, j)] + s[at(i - 1, j)] + s[at(i, j - 1)] - s[at(i - 1, j - 1)];
+        for (int i = 1; i <= n; i++)
+            for (int j = 1; j <= m; j++) s[at(i, j)] += s[at(i - 1, j)] + s[at(i, j - 1)] - s[at(i - 1, j - 1)];
+    }
+    LL query(int x1, int y1, int x2, int y2) const {
+        return s[at(x2, y2)] - s[at(x1 - 1, y2)] - s[at(x2, y1 - 1)] + s[at(x1 - 1, y1 - 1)];
+    }
+};
+
+void benchmark(int side, int ops) {
+    mt19937 rng(20260108);
+    int n = side, m = side;
+    vector<int> a((size_t)n * m);
+    for (auto& x : a) x = rng() % 1000;
+
+    vector<Op> seq(ops);
+    for (auto& op : seq) {
+        int x1 = rng() % n + 1, x2 = rng() % n + 1, y1 = rng() % m + 1, y2 = rng() % m + 1;
+        op = {(int)(rng() % 2) + 1, min(x1, x2), min(y1, y2), max(x1, x2), max(y1, y2), (int)(rng() % 2001) - 1000};
+    }
+    printf("grid %d x %d, %d mixed ops (half add, half query)\n", n, m, ops);
+
+    Fenwick2D fw;
+    auto st = chrono::steady_clock::now();
+    fw.build(a.data(), n, m, m);
+    printf("  fenwick bulk build        %9.1f ms\n", bench::elapsed_ms(st));
+
+    RebuildTable rt;
+    st = chrono::steady_clock::now();
+    rt.build(a.data(), n, m);
+    rt.rebuild();
+    double t_rebuild = bench::elapsed_ms(st);
+    printf("  prefix table build        %9.1f ms\n", t_rebuild);
+
+    vector<LL> r1, r2;
+    st = chrono::steady_clock::now();
+    for (auto& op : seq) {
+        if (op.type == 1) fw.range_add(op.x1, op.y1, op.x2, op.y2, op.c);
+        else r1.push_back(fw.range_sum(op.x1, op.y1, op.x2, op.y2));
+    }
+    double t_fw = bench::elapsed_ms(st);
+
+    // 对照组：只在"改过之后的第一次查询"前重建
+    int rebuilds = 0;
+    bool dirty = false;
+    st = chrono::steady_clock::now();
+    for (auto& op : seq) {
+        if (op.type == 1) rt.insert(op.x1, op.y1, op.x2, op.y2, op.c), dirty = true;
+        else {
+            if (dirty) rt.rebuild(), rebuilds++, dirty = false;
+            r2.push_back(rt.query(op.x1, op.y1, op.x2, op.y2));
+        }
+    }
+    double t_rt = bench::elapsed_ms(st);
+
+    printf("  fenwick ops               %9.1f ms  (%.2f us/op)\n", t_fw, t_fw * 1000 / ops);
+    printf("  rebuild-on-query ops      %9.1f ms  (%d rebuilds)\n", t_rt, rebuilds);
+    printf("  results %s\n", r1 == r2 ? "identical" : "MISMATCH!");
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int side = argc >= 3 ? atoi(argv[2]) : 4096;
+        int ops = argc >= 4 ? atoi(argv[3]) : 400;
+        benchmark(side, ops);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    int n, m, q;
+    if (!(cin >> n >> m >> q)) return 0;
+    vector<int> a((size_t)n * m);
+    for (auto& x : a) cin >> x;
+
+    Fenwick2D fw;
+    fw.build(a.data(), n, m, m);
+    while (q--) {
+        int type, x1, y1, x2, y2;
+        cin >> type >> x1 >> y1 >> x2 >> y2;
+        if (type == 1) {
+            int c;
+            cin >> c;
+            fw.range_add(x1, y1, x2, y2, c);
+        } else {
+            cout << fw.range_sum(x1, y1, x2, y2) << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * ============================================
+ *   在线差分 - 双树状数组 (区间加 + 单点查 / 区间和) + 批量更新
+ *   基于 11_difference.cpp 的 insert(l, r, c)
+ *   题目来源: AcWing 797. 差分 / AcWing 243. 一个简单的整数问题2
+ * ============================================
+ *
+ * 【原版的局限】
+ *   insert 只改差分数组 b 的两个点，最后统一求一遍前缀和还原 a。
+ *   只要中途想问一次 "a[i] 现在是多少" 或 "a[l..r] 的和"，就得 O(n) 重新求前缀和。
+ *   流式计数器是"改一批 -> 查一次 -> 再改一批"，每次查询都 O(n) 扛不住。
+ *
+ * 【思路：把 b 放进树状数组】
+ *   1. 单点查：a[x] = b[1] + ... + b[x]，这是 b 的前缀和，树状数组 O(log n)。
+ *   2. 区间和：a[1..x] 的和里 b[i] 被加了 (x - i + 1) 次，
+ *        S(x) = Σ b[i] * (x + 1 - i) = (x + 1) * Σ b[i] - Σ (b[i] * i)
+ *      所以再开第二棵树状数组维护 b[i] * i，两棵树各查一次就得到前缀和。
+ *   insert(l, r, c) 还是只改 b[l] 和 b[r+1]，每棵树 O(log n)。
+ *   (和 10_prefix_sum_2d_fenwick.cpp 同一个展开式，那边是二维的 4 棵树)
+ *
+ * 【批量更新：攒一批再一起改】
+ *   add_lazy 只把 (l, r, c) 记进待处理队列，下一次查询前统一 flush：
+ *   - 队列短：逐个走树状数组，k 次 O(log n)；
+ *   - 队列长 (2k * log n 超过 n)：k 个 insert 直接 O(1) 打在一个空的增量差分数组 d 上，
+ *     再一趟 O(n) 把 d 线性建成树状数组、顺手加进 t (树状数组对加法是线性的)。
+ *   于是一次 flush 的代价是 min(k log n, n + k)，一大批更新之后只付一次 O(n)。
+ *
+ *   线性建树：t[i] 加到父亲 t[i + lowbit(i)] 上，i 从小到大 (走到 i 时它的孩子都已加完)；
+ *   还原就是倒过来：i 从大到小，t[i + lowbit(i)] -= t[i] (snapshot 用)。
+ *
+ * 【复杂度】
+ *   - 区间加 / 单点查 / 区间和：O(log n)
+ *   - 批量 k 个区间加：O(min(k log n, n + k))
+ *   - 空间：2 棵树状数组 + 1 个增量数组 + 待处理队列
+ *
+ * 【用法】
+ *   ./a.out            AcWing 797：读入 n m、数组、m 个 (l r c)，输出最终数组
+ *   ./a.out online     读入 n m、数组、m 个操作 (边改边查)：
+ *                      C l r c  区间加 c；  Q l r  区间和；  P x  单点值
+ *   ./a.out bench [n] [批数] [每批更新数]
+ *   编译: g++ -std=c++17 -O2 11_difference_online.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+struct OnlineDifference {
+    struct Update {
+        int l, r;
+        LL c;
+    };
+
+    // 两棵树状数组交错存放：同一个下标的 b 和 b*i 在同一条缓存行里，一次访存拿到两个
+    struct Node {
+        LL b, bi; // b[i] 的树状数组 / b[i] * i 的树状数组
+        void operator+= (const Node& o) { b += o.b, bi += o.bi; }
+        void operator-= (const Node& o) { b -= o.b, bi -= o.bi; }
+    };
+
+    int n = 0, lg = 1;
+    vector<Node> t;         // 下标从 1 开始
+    vector<Node> d;         // flush 用的增量差分数组，用完清零
+    vector<Update> pending; // add_lazy 攒下来还没生效的区间加
+
+    OnlineDifference() {}
+    explicit OnlineDifference(int n_) { init(n_); }
+
+    void init(int n_) {
+        n = n_;
+        lg = 1;
+        while ((1 << lg) <= n) lg++;
+        t.assign(n + 2, Node{0, 0});
+        d.assign(n + 2, Node{0, 0});
+        pending.clear();
+    }
+
+    // 从初始数组 a[1..n] 建树，O(n)
+    void build(const LL* a, int n_) {
+        init(n_);
+        for (int i = 1; i <= n; i++) {
+            LL b = a[i] - a[i - 1]; // 差分
+            t[i] = {b, b * i};
+        }
+        link();
+    }
+
+    // ---------- 树状数组基本操作 ----------
+    void add_point(int x, LL c) {
+        Node w = {c, c * x};
+        for (int i = x; i <= n; i += i & -i) t[i] += w;
+    }
+
+    // S(x) = a[1] + ... + a[x]
+    LL prefix_sum(int x) const {
+        Node s = {0, 0};
+        for (int i = x; i > 0; i -= i & -i) s += t[i];
+        return (LL)(x + 1) * s.b - s.bi;
+    }
+
+    // 线性建树：自己加到父亲上 (走到 i 时它的孩子都已加完)；unlink 是它的逆过程
+    void link() {
+        for (int i = 1; i <= n; i++) {
+            int p = i + (i & -i);
+            if (p <= n) t[p] += t[i];
+        }
+    }
+    void unlink() {
+        for (int i = n; i >= 1; i--) {
+            int p = i + (i & -i);
+            if (p <= n) t[p] -= t[i];
+        }
+    }
+
+    // ---------- 在线接口 ----------
+
+    // 立即生效：a[l..r] 每个数加 c
+    void insert(int l, int r, LL c) {
+        add_point(l, c);
+        if (r + 1 <= n) add_point(r + 1, -c);
+    }
+
+    // 攒着，下次查询前一起生效
+    void add_lazy(int l, int r, LL c) { pending.push_back({l, r, c}); }
+
+    void add_batch(const Update* us, int k) {
+        pending.insert(pending.end(), us, us + k);
+    }
+
+    // 让所有待处理的区间加生效，按代价选逐个更新或整体重建
+    void flush() {
+        if (pending.empty()) return;
+        if ((LL)pending.size() * lg * 2 <= n) { // 顺序扫描比随机访存便宜，但要读写 t 和 d 两个数组
+            for (auto& u : pending) insert(u.l, u.r, u.c);
+        } else {
+            // 树状数组对加法是线性的：增量单独打在 d 上，一趟扫描把 d 建成树、顺手加进 t
+            for (auto& u : pending) {
+                d[u.l] += Node{u.c, u.c * u.l};
+                if (u.r + 1 <= n) d[u.r + 1] -= Node{u.c, u.c * (u.r + 1)};
+            }
+            for (int i = 1; i <= n; i++) {
+                int p = i + (i & -i);
+                if (p <= n) d[p] += d[i];
+                t[i] += d[i];
+                d[i] = {0, 0};
+            }
+        }
+        pending.clear();
+    }
+
+    LL query(int x) { // a[x]
+        flush();
+        LL s = 0;
+        for (int i = x; i > 0; i -= i & -i) s += t[i].b;
+        return s;
+    }
+
+    LL query(int l, int r) { // a[l] + ... + a[r]
+        flush();
+        return prefix_sum(r) - prefix_sum(l - 1);
+    }
+
+    // 导出整个数组 a[1..n]，O(n)
+    vector<LL> snapshot() {
+        flush();
+        vector<LL> a(n + 1, 0);
+        unlink();
+        for (int i = 1; i <= n; i++) a[i] = a[i - 1] + t[i].b;
+        link();
+        return a;
+    }
+};
+
+// ========== 基准测试 ==========
+void benchmark(int n, int rounds, int per_round) {
+    mt19937 rng(20260109);
+    vector<LL> a(n + 1, 0);
+    for (int i = 1; i <= n; i++) a[i] = rng() % 1000;
+
+    struct Op {
+        int l, r, c;
+    };
+    vector<Op> ups((size_t)rounds * per_round), qs(rounds);
+    for (auto& u : ups) {
+        int l = rng() % n + 1, r = rng() % n + 1;
+        u = {min(l, r), max(l, r), (int)(rng() % 2001) - 1000};
+    }
+    for (auto& q : qs) {
+        int l = rng() % n + 1, r = rng() % n + 1;
+        q = {min(l, r), max(l, r), 0};
+    }
+    printf("n = %d, %d rounds x (%d range adds + 1 range sum)\n", n, rounds, per_round);
+
+    // 1. 原版：差分数组 + 每次查询前 O(n) 求前缀和
+    vector<LL> ref;
+    auto st = chrono::steady_clock::now();
+    {
+        vector<LL> b(n + 2, 0), s(n + 1, 0);
+        for (int i = 1; i <= n; i++) b[i] = a[i] - a[i - 1];
+        for (int k = 0; k < rounds; k++) {
+            for (int j = 0; j < per_round; j++) {
+                auto& u = ups[(size_t)k * per_round + j];
+                b[u.l] += u.c, b[u.r + 1] -= u.c;
+            }
+            LL cur = 0, sum = 0;
+            for (int i = 1; i <= n; i++) cur += b[i], sum += cur, s[i] = sum;
+            ref.push_back(s[qs[k].r] - s[qs[k].l - 1]);
+        }
+    }
+    double t_orig = bench::elapsed_ms(st);
+
+    auto run = [&](bool lazy) {
+        vector<LL> got;
+        OnlineDifference od;
+        od.build(a.data(), n);
+        for (int k = 0; k < rounds; k++) {
+            for (int j = 0; j < per_round; j++) {
+                auto& u = ups[(size_t)k * per_round + j];
+                if (lazy) od.add_lazy(u.l, u.r, u.c);
+                else od.insert(u.l, u.r, u.c);
+            }
+            got.push_back(od.query(qs[k].l, qs[k].r));
+        }
+        return got;
+    };
+
+    st = chrono::steady_clock::now();
+    bool ok1 = run(false) == ref;
+    double t_online = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    bool ok2 = run(true) == ref;
+    double t_lazy = bench::elapsed_ms(st);
+
+    bench::row("rebuild prefix per query", t_orig, true, 28);
+    bench::row("dual fenwick, insert", t_online, ok1, 28);
+    bench::row("dual fenwick, add_lazy", t_lazy, ok2, 28);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int rounds = argc >= 4 ? atoi(argv[3]) : 1000;
+        int per_round = argc >= 5 ? atoi(argv[4]) : 100;
+        benchmark(n, rounds, per_round);
+        return 0;
+    }
+    bool online = argc >= 2 && strcmp(argv[1], "online") == 0;
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    int n, m;
+    if (!(cin >> n >> m)) return 0;
+    vector<LL> a(n + 1, 0);
+    for (int i = 1; i <= n; i++) cin >> a[i];
+
+    OnlineDifference od;
+    od.build(a.data(), n);
+
+    if (!online) {
+        // AcWing 797: 输入 6 3 / 1 2 2 1 2 1 / 1 3 1 / 3 5 1 / 1 6 1，输出 3 4 5 3 4 2
+        while (m--) {
+            int l, r, c;
+            cin >> l >> r >> c;
+            od.add_lazy(l, r, c);
+        }
+        auto res = od.snapshot();
+        for (int i = 1; i <= n; i++) cout << res[i] << " ";
+        cout << endl;
+        return 0;
+    }
+
+    while (m--) {
+        char op;
+        cin >> op;
+        if (op == 'C') {
+            int l, r, c;
+            cin >> l >> r >> c;
+            od.insert(l, r, c);
+        } else if (op == 'Q') {
+            int l, r;
+            cin >> l >> r;
+            cout << od.query(l, r) << "\n";
+        } else {
+            int x;
+            cin >> x;
+            cout << od.query(x) << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * ============================================
+ *   批量离散化 - 一次排序 (键, 下标) 直接回填排名
+ *   基于 20_discretization.cpp (sort + unique + find) / 23_radix_sort.cpp
+ *   题目来源: AcWing 802. 区间和
+ * ============================================
+ *
+ * 【原版慢在哪】
+ *   sort(alls) + unique 之后，每次加值、每个查询端点都要 find(x) 二分一次：
+ *   10^7 次操作就是 10^7 次 lower_bound，每次 ~23 步且几乎步步缓存未命中，
+ *   比排序本身还贵。
+ *
+ * 【一次排序，回填排名】
+ *   所有要离散化的键 (加值位置 x、查询端点 l, r) 排成一个数组 keys[0..K)，
+ *   把 (键, 原下标) 打包成一个 64 位数：高 32 位是保序后的键，低 32 位是下标。
+ *
+ *     keys:    [ 7,  1,  3,  1 ]
+ *     打包:    (7,0) (1,1) (3,2) (1,3)
+ *     按键排:  (1,1) (1,3) (3,2) (7,0)
+ *     排名:      1     1     2     3      <- 顺序扫一遍，键变了排名 +1
+ *     回填:    rank[1] = 1, rank[3] = 1, rank[2] = 2, rank[0] = 3
+ *
+ *   排序只看高 32 位，用 23_radix_sort 的 LSD 基数排序，4 趟 (常量字节自动跳过)。
+ *   扫描时顺手把去重后的键写进 alls，和原版的 alls 完全一样。
+ *   之后每个操作直接拿 rank[i]，不再二分。
+ *
+ * 【哈希路径：排序之后再来的零散查询】
+ *   有些键事先收集不到 (比如在线来的查询)，但一定在 alls 里。
+ *   对 alls 建一张开放寻址哈希表 (键 -> 排名)，查询 O(1) 期望，代替 lower_bound。
+ *   find(x) 只认表里的键，不在就返回 0；lower(x, alls) 要的是"第一个 >= x"的排名，
+ *   先查表，不在表里才回退到 lower_bound (键不在 alls 里的查询只有这部分是 O(log D))。
+ *
+ * 【压缩后的区间和】
+ *   - 所有加值都在查询前：a[rank] += c，前缀和表 s，查询 O(1) (原版做法)；
+ *   - 加值和查询交错：树状数组，排名已经批量算好，每个操作只剩 O(log K)。
+ *
+ * 【复杂度】
+ *   - 批量离散化：O(K) 基数排序 + O(K) 扫描回填
+ *   - 哈希表：建表 O(D)，查询期望 O(1) (D = 去重后的坐标数)
+ *
+ * 【用法】
+ *   ./a.out                       AcWing 802：读入 n m、n 个 (x c)、m 个 (l r)，输出区间和
+ *   ./a.out bench [加值数] [查询数]
+ *   编译: g++ -std=c++17 -O2 20_discretization_bulk.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef pair<int, int> PII;
+
+// ========== 批量离散化 ==========
+
+// 23_radix_sort 的保序映射：翻转符号位
+inline uint32_t radix_key(int x) { return (uint32_t)x ^ 0x80000000u; }
+
+// 按高 32 位 (键) 对打包的 (键, 下标) 做 LSD 基数排序
+void radix_sort_high32(vector<uint64_t>& a) {
+    int n = a.size();
+    if (n <= 1) return;
+    vector<int> cnt(4 * 256, 0);
+    for (uint64_t x : a)
+        for (int b = 0; b < 4; b++) cnt[b * 256 + (x >> (32 + 8 * b) & 255)]++;
+
+    vector<uint64_t> buf(n);
+    uint64_t* src = a.data();
+    uint64_t* dst = buf.data();
+    for (int b = 0; b < 4; b++) {
+        int* c = &cnt[b * 256];
+        int shift = 32 + 8 * b;
+        if (c[a[0] >> shift & 255] == n) continue; // 这个字节全都一样，跳过
+        int sum = 0;
+        for (int v = 0; v < 256; v++) {
+            int t = c[v];
+            c[v] = sum;
+            sum += t;
+        }
+        for (int i = 0; i < n; i++) dst[c[src[i] >> shift & 255]++] = src[i];
+        swap(src, dst);
+    }
+    if (src != a.data()) memcpy(a.data(), src, sizeof(uint64_t) * n);
+}
+
+// ⚡ keys[0, K) -> rank[0, K)，排名从 1 开始 (和原版 find 一致)；alls 收到去重后的有序键
+void compress(const int* keys, int K, int* rank, vector<int>& alls) {
+    vector<uint64_t> packed(K);
+    for (int i = 0; i < K; i++) packed[i] = (uint64_t)radix_key(keys[i]) << 32 | (uint32_t)i;
+    radix_sort_high32(packed);
+
+    alls.clear();
+    int r = 0;
+    uint32_t last = 0;
+    for (int i = 0; i < K; i++) {
+        uint32_t k = packed[i] >> 32;
+        if (r == 0 || k != last) {
+            last = k, r++;
+            alls.push_back((int)(k ^ 0x80000000u));
+        }
+        rank[(uint32_t)packed[i]] = r;
+    }
+}
+
+// 哈希路径：alls 里的键 -> 排名，不在表里返回 0 (要回退用 lower)
+struct RankHash {
+    vector<int> key, val; // val == 0 表示空槽
+    int mask = 0, shift = 0;
+
+    void build(const vector<int>& alls) {
+        int cap = 2;
+        while (cap < 2 * (int)alls.size()) cap *= 2; // 负载因子 <= 1/2
+        mask = cap - 1;
+        shift = 64 - __builtin_ctz(cap);
+        key.assign(cap, 0);
+        val.assign(cap, 0);
+        for (int i = 0; i < (int)alls.size(); i++) {
+            int h = slot(alls[i]);
+            while (val[h]) h = (h + 1) & mask;
+            key[h] = alls[i], val[h] = i + 1;
+        }
+    }
+
+    // Fibonacci 哈希：乘黄金比例常数取高位
+    int slot(int x) const { return (int)((uint64_t)(uint32_t)x * 0x9E3779B97F4A7C15ull >> shift); }
+
+    int find(int x) const {
+        for (int h = slot(x); val[h]; h = (h + 1) & mask)
+            if (key[h] == x) return val[h];
+        return 0;
+    }
+
+    // 第一个 >= x 的键的排名 (alls 必须是 build 时那一份)；都比 x 小时返回 alls.size() + 1
+    int lower(int x, const vector<int>& alls) const {
+        if (int r = find(x)) return r;
+        return int(lower_bound(alls.begin(), alls.end(), x) - alls.begin() + 1);
+    }
+};
+
+// 加值和查询交错时用的树状数组 (下标 1..n)
+struct Fenwick {
+    vector<LL> t;
+    explicit Fenwick(int n) : t(n + 1, 0) {}
+    void add(int x, LL c) {
+        for (int i = x; i < (int)t.size(); i += i & -i) t[i] += c;
+    }
+    LL sum(int x) const {
+        LL s = 0;
+        for (int i = x; i > 0; i -= i & -i) s += t[i];
+        return s;
+    }
+};
+
+// AcWing 802：adds 全部在查询之前，keys 排成 [x..., l..., r...] 一次离散化
+vector<LL> interval_sums(const vector<PII>& adds, const vector<PII>& queries) {
+    int n = adds.size(), m = queries.size(), K = n + 2 * m;
+    vector<int> keys(K), rank(K), alls;
+    for (int i = 0; i < n; i++) keys[i] = adds[i].first;
+    for (int i = 0; i < m; i++) keys[n + i] = queries[i].first, keys[n + m + i] = queries[i].second;
+    compress(keys.data(), K, rank.data(), alls);
+
+    vector<LL> s(alls.size() + 1, 0);
+    for (int i = 0; i < n; i++) s[rank[i]] += adds[i].second;
+    for (size_t i = 1; i < s.size(); i++) s[i] += s[i - 1];
+
+    vector<LL> res(m);
+    for (int i = 0; i < m; i++) res[i] = s[rank[n + m + i]] - s[rank[n + i] - 1];
+    return res;
+}
+
+// ========== 基准测试 ==========
+// 原版流程 (对照组)：sort + unique + 每次 find 二分
+vector<LL> interval_sums_original(const vector<PII>& adds, const vector<PII>& queries) {
+    vector<int> alls;
+    for (auto& p : adds) alls.push_back(p.first);
+    for (auto& q : queries) alls.push_back(q.first), alls.push_back(q.second);
+    sort(alls.begin(), alls.end());
+    alls.erase(unique(alls.begin(), alls.end()), alls.end());
+    auto find = [&](int x) { return int(lower_bound(alls.begin(), alls.end(), x) - alls.begin() + 1); };
+
+    vector<LL> s(alls.size() + 1, 0);
+    for (auto& p : adds) s[find(p.first)] += p.second;
+    for (size_t i = 1; i < s.size(); i++) s[i] += s[i - 1];
+    vector<LL> res;
+    for (auto& q : queries) res.push_back(s[find(q.second)] - s[find(q.first) - 1]);
+    return res;
+}
+
+void benchmark(int n, int m) {
+    mt19937 rng(20260110);
+    auto coord = [&]() { return (int)(rng() % 2000000001u) - 1000000000; };
+    vector<PII> adds(n), queries(m);
+    for (auto& p : adds) p = {coord(), (int)(rng() % 20001) - 10000};
+    for (auto& q : queries) {
+        int l = coord(), r = coord();
+        q = {min(l, r), max(l, r)};
+    }
+    printf("%d adds + %d queries = %d keys\n", n, m, n + 2 * m);
+
+    auto st = chrono::steady_clock::now();
+    auto ref = interval_sums_original(adds, queries);
+    double t_orig = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    auto got = interval_sums(adds, queries);
+    double t_bulk = bench::elapsed_ms(st);
+    bool ok1 = got == ref;
+
+    // 哈希路径：alls 已知 (离散化一次)，之后所有端点都走哈希表 + 树状数组在线回答
+    vector<int> keys, rank, alls;
+    for (auto& p : adds) keys.push_back(p.first);
+    for (auto& q : queries) keys.push_back(q.first), keys.push_back(q.second);
+    rank.resize(keys.size());
+    compress(keys.data(), keys.size(), rank.data(), alls);
+
+    st = chrono::steady_clock::now();
+    RankHash h;
+    h.build(alls);
+    Fenwick fw(alls.size());
+    for (auto& p : adds) fw.add(h.find(p.first), p.second);
+    vector<LL> got2;
+    for (auto& q : queries) got2.push_back(fw.sum(h.find(q.second)) - fw.sum(h.find(q.first) - 1));
+    double t_hash = bench::elapsed_ms(st);
+    bool ok2 = got2 == ref;
+
+    // 单独比较 "映射" 这一步：lower_bound vs 哈希
+    LL sum1 = 0, sum2 = 0;
+    st = chrono::steady_clock::now();
+    for (int x : keys) sum1 += lower_bound(alls.begin(), alls.end(), x) - alls.begin() + 1;
+    double t_lb = bench::elapsed_ms(st);
+    st = chrono::steady_clock::now();
+    for (int x : keys) sum2 += h.find(x);
+    double t_find = bench::elapsed_ms(st);
+    // 不在 alls 里的键：lower 回退到 lower_bound，结果必须和直接二分一样
+    for (int i = 0; i < 100000; i++) {
+        int x = coord();
+        sum1 += lower_bound(alls.begin(), alls.end(), x) - alls.begin() + 1;
+        sum2 += h.lower(x, alls);
+    }
+
+    bench::row("original sort + find per op", t_orig, true, 36);
+    bench::row("bulk compress + prefix table", t_bulk, ok1, 36);
+    bench::row("hash build + lookups + fenwick", t_hash, ok2, 36);
+    bench::row("  mapping only: lower_bound", t_lb, true, 36);
+    bench::row("  mapping only: hash find", t_find, sum1 == sum2, 36);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 5000000;
+        int m = argc >= 4 ? atoi(argv[3]) : 2500000;
+        benchmark(n, m);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 802: 输入 3 3 / 1 2 / 3 6 / 7 5 / 1 3 / 4 6 / 7 8，输出 8 / 0 / 5
+    int n, m;
+    if (!(cin >> n >> m)) return 0;
+    vector<PII> adds(n), queries(m);
+    for (auto& p : adds) cin >> p.first >> p.second;
+    for (auto& q : queries) cin >> q.first >> q.second;
+
+    for (LL x : interval_sums(adds, queries)) cout << x << "\n";
+    return 0;
+}
@@ -0,0 +1,323 @@
+/*
+ * ============================================
+ *   外存区间合并 + 静态区间索引 (刺穿查询 / 覆盖长度)
+ *   基于 21_interval_merge.cpp 的 merge(segs)
+ *   题目来源: AcWing 803. 区间合并
+ * ============================================
+ *
+ * 【原版的局限】
+ *   merge(segs) 要把所有区间读进内存再 sort 一遍。10^9 条日志区间放不下；
+ *   而且每问一次"x 落在哪些区间里"、"[a, b] 被盖住了多少"都要重新合并一遍。
+ *
+ * 【流式合并：多个有序段，有界内存】
+ *   日志本来就是分文件、按左端点有序写出的 (或先用外部排序切成有序段)。
+ *   原版的贪心只要求"按左端点从小到大看到每个区间"，不要求它们同时在内存里：
+ *
+ *     run0: [1,3] [6,8] ...      每个 run 只留一小块读缓冲
+ *     run1: [2,5] [9,9] ...  ->  败者树挑出左端点最小的队首  ->  贪心维护 [st, ed]
+ *     run2: [4,4] ...            相离就把 [st, ed] 写出去
+ *
+ *   内存 = k 个读缓冲 + 1 个写缓冲，和区间总数无关。
+ *   挑队首用共用头文件 ../loser_tree.h 的流式败者树 (和 22 的外部排序同一份代码)，
+ *   每个 run 是一个 FileRun<PII>：每个区间一条路径 ceil(log k) 次比较。
+ *
+ * 【静态索引：建一次，查 O(log n)】
+ *   1. 计数：包含 x 的区间数 = #(l <= x) - #(r < x)
+ *      左端点、右端点各排一个有序数组 (sorted endpoint array)，两次二分。
+ *   2. 列举：按左端点排好序后，l <= x 的恰好是前缀 [0, p)，
+ *      在这个前缀里找 r >= x 的。对 r 建一棵"区间最大值"的隐式树 (和线段树同构，数组存)：
+ *
+ *               max r = 9
+ *              /         \
+ *          max 5        max 9          子树的 max r < x 就整棵剪掉，
+ *          /   \        /   \          只往"可能有答案"的子树里走
+ *       [1,3] [2,5]  [4,4] [6,9]
+ *
+ *      每报告一个答案最多多走 O(log n) 个结点，总共 O((1 + k) log n)。
+ *   3. 覆盖长度：把区间合并成互不相交的 [st_i, ed_i]，长度做前缀和 pre。
+ *      [a, b] 内被覆盖的点数 = 整段落在里面的用 pre 差直接算，两头被切开的各补一截。
+ *      区间是闭区间、坐标是整数，所以 [st, ed] 的长度按点数算 = ed - st + 1。
+ *
+ * 【复杂度】
+ *   - 流式合并：O(N log k) 时间，O(k * 块大小) 内存
+ *   - 建索引：O(n log n)；计数 / 覆盖长度 O(log n)；列举 O((1 + k) log n)
+ *
+ * 【用法】
+ *   ./a.out                          AcWing 803：读入 n 和 n 个区间，输出合并后的区间个数
+ *   ./a.out merge <输出> <run1> ...  流式合并若干按左端点有序的二进制 (int32 l, int32 r) 文件
+ *   ./a.out bench [n] [run 数] [查询数]
+ *   编译: g++ -std=c++17 -O2 21_interval_merge_external.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <chrono>
+#include <random>
+#include "../loser_tree.h"
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef pair<int, int> PII;
+
+// ========== 原版 merge (对照组) ==========
+vector<PII> merge(vector<PII>& segs) {
+    vector<PII> res;
+    sort(segs.begin(), segs.end());
+    int st = -2e9, ed = -2e9;
+    for (auto seg : segs) {
+        if (ed < seg.first) {
+            if (st != -2e9) res.push_back({st, ed});
+            st = seg.first, ed = seg.second;
+        } else ed = max(ed, seg.second);
+    }
+    if (st != -2e9) res.push_back({st, ed});
+    return res;
+}
+
+// ========== 流式合并 ==========
+const size_t BLOCK = 1 << 16; // 每个 run 的读缓冲 (区间个数)
+
+using kway::FileRun;
+using kway::LoserTree;
+
+// 贪心扫描，改成"一次喂一个区间"：区间必须按左端点不减的顺序到来
+template <class Emit>
+struct StreamMerger {
+    Emit emit; // emit(st, ed)：输出一段合并好的区间
+    bool open = false;
+    int st = 0, ed = 0;
+
+    explicit StreamMerger(Emit e) : emit(e) {}
+
+    void push(int l, int r) {
+        if (!open || ed < l) {
+            if (open) emit(st, ed);
+            st = l, ed = r, open = true;
+        } else ed = max(ed, r);
+    }
+    void finish() {
+        if (open) emit(st, ed);
+        open = false;
+    }
+};
+
+// ⚡ 合并 k 个有序 run，每段结果交给 emit；返回读入的区间总数
+template <class Emit>
+LL merge_runs(vector<FILE*>& runs, Emit emit) {
+    vector<FileRun<PII>> rd;
+    for (FILE* f : runs) rd.emplace_back(f, BLOCK);
+
+    // 左端点相同时按右端点、再按 run 编号，和原来 pair<区间, run> 的小根堆同序
+    LoserTree<PII, FileRun<PII>> lt(rd);
+    StreamMerger<Emit> m(emit);
+    LL cnt = 0;
+    PII x;
+    while (lt.pop(x)) m.push(x.first, x.second), cnt++;
+    m.finish();
+    return cnt;
+}
+
+// ========== 静态区间索引 ==========
+struct IntervalIndex {
+    int n = 0;
+    vector<PII> segs;        // 按左端点排序的原始区间
+    vector<int> ls, rs;      // 左端点、右端点各自有序
+    vector<int> mx;          // 隐式树：mx[u] = 子树里最大的 r
+    vector<PII> merged;      // 合并后互不相交的区间
+    vector<LL> pre;          // pre[i] = merged[0..i) 的总长度
+
+    explicit IntervalIndex(vector<PII> s) : segs(move(s)) {
+        n = segs.size();
+        sort(segs.begin(), segs.end());
+        for (auto& p : segs) ls.push_back(p.first), rs.push_back(p.second);
+        sort(rs.begin(), rs.end());
+        mx.assign(4 * max(n, 1), INT_MIN);
+        if (n) build(1, 0, n - 1);
+
+        // segs 已经按左端点有序，直接喂给流式合并 (原版 merge 拿 -2e9 当哨兵，左端点 -2e9 的区间会丢)
+        auto emit = [&](int l, int r) { merged.push_back({l, r}); };
+        StreamMerger<decltype(emit)> m(emit);
+        for (auto& p : segs) m.push(p.first, p.second);
+        m.finish();
+        pre.assign(merged.size() + 1, 0);
+        for (size_t i = 0; i < merged.size(); i++)
+            pre[i + 1] = pre[i] + (LL)merged[i].second - merged[i].first + 1;
+    }
+
+    void build(int u, int l, int r) {
+        if (l == r) {
+            mx[u] = segs[l].second;
+            return;
+        }
+        int mid = (l + r) >> 1;
+        build(2 * u, l, mid), build(2 * u + 1, mid + 1, r);
+        mx[u] = max(mx[2 * u], mx[2 * u + 1]);
+    }
+
+    // 包含 x 的区间个数
+    int count(int x) const {
+        int le = upper_bound(ls.begin(), ls.end(), x) - ls.begin(); // l <= x
+        int lt = lower_bound(rs.begin(), rs.end(), x) - rs.begin(); // r < x
+        return le - lt;
+    }
+
+    // 在下标 [0, p) 里找 r >= x 的区间
+    void collect(int u, int l, int r, int p, int x, vector<PII>& out) const {
+        if (l >= p || mx[u] < x) return;
+        if (l == r) {
+            out.push_back(segs[l]);
+            return;
+        }
+        int mid = (l + r) >> 1;
+        collect(2 * u, l, mid, p, x, out);
+        collect(2 * u + 1, mid + 1, r, p, x, out);
+    }
+
+    // 包含 x 的所有区间 (按左端点有序)
+    vector<PII> stab(int x) const {
+        vector<PII> out;
+        int p = upper_bound(ls.begin(), ls.end(), x) - ls.begin();
+        if (p) collect(1, 0, n - 1, p, x, out);
+        return out;
+    }
+
+    // [a, b] 里被至少一个区间盖住的整点个数
+    LL covered(int a, int b) const {
+        if (a > b || merged.empty()) return 0;
+        // i: 第一个 ed >= a 的段；j: 最后一个 st <= b 的段 (下标 j - 1)
+        int i = lower_bound(merged.begin(), merged.end(), a,
+                            [](const PII& s, int v) { return s.second < v; }) - merged.begin();
+        int j = upper_bound(merged.begin(), merged.end(), b,
+                            [](int v, const PII& s) { return v < s.first; }) - merged.begin();
+        if (i >= j) return 0;
+        LL res = pre[j] - pre[i];
+        if (merged[i].first < a) res -= (LL)a - merged[i].first;          // 左边切掉一截
+        if (merged[j - 1].second > b) res -= (LL)merged[j - 1].second - b; // 右边切掉一截
+        return res;
+    }
+};
+
+// ========== 基准测试 ==========
+void benchmark(int n, int k, int qs) {
+    mt19937 rng(20260112);
+    vector<PII> segs(n);
+    for (auto& s : segs) {
+        int l = rng() % 1000000000;
+        s = {l, l + (int)(rng() % 2000)};
+    }
+    printf("n = %d intervals in %d sorted runs, %d queries\n", n, k, qs);
+
+    // 写 k 个有序 run (tmpfile 关闭即删除)
+    vector<FILE*> runs;
+    for (int i = 0; i < k; i++) {
+        vector<PII> part(segs.begin() + (LL)n * i / k, segs.begin() + (LL)n * (i + 1) / k);
+        sort(part.begin(), part.end());
+        FILE* f = tmpfile();
+        if (!f) return;
+        if (!part.empty()) fwrite(part.data(), sizeof(PII), part.size(), f);
+        rewind(f);
+        runs.push_back(f);
+    }
+
+    vector<PII> tmp = segs;
+    auto st = chrono::steady_clock::now();
+    auto ref = merge(tmp);
+    double t_mem = bench::elapsed_ms(st);
+
+    vector<PII> got;
+    st = chrono::steady_clock::now();
+    merge_runs(runs, [&](int l, int r) { got.push_back({l, r}); });
+    double t_stream = bench::elapsed_ms(st);
+    for (FILE* f : runs) fclose(f);
+    bench::row("in-memory sort + merge", t_mem);
+    printf("  %-34s %9.1f ms  (%zu merged)%s\n", "streaming merge of runs", t_stream, got.size(),
+           bench::check(got == ref));
+
+    st = chrono::steady_clock::now();
+    IntervalIndex idx(segs);
+    bench::row("build index", bench::elapsed_ms(st));
+
+    vector<PII> q(qs);
+    for (auto& x : q) {
+        int a = rng() % 1000000000, b = rng() % 1000000000;
+        x = {min(a, b), max(a, b)};
+    }
+
+    // 每次查询都重新扫一遍合并结果 (对照组，已经合并好也要 O(n))
+    LL s1 = 0, s2 = 0, c1 = 0, c2 = 0;
+    int naive_q = min(qs, 200);
+    st = chrono::steady_clock::now();
+    for (int i = 0; i < naive_q; i++) {
+        for (auto& m : ref) {
+            LL lo = max(m.first, q[i].first), hi = min(m.second, q[i].second);
+            if (lo <= hi) s1 += hi - lo + 1;
+        }
+        for (auto& s : segs) c1 += s.first <= q[i].first && q[i].first <= s.second;
+    }
+    double t_naive = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    for (int i = 0; i < qs; i++) {
+        LL cv = idx.covered(q[i].first, q[i].second);
+        int ct = idx.count(q[i].first);
+        if (i < naive_q) s2 += cv, c2 += ct;
+    }
+    double t_idx = bench::elapsed_ms(st);
+
+    bool ok = s1 == s2 && c1 == c2;
+    for (int i = 0; i < min(qs, 1000) && ok; i++) ok = (int)idx.stab(q[i].first).size() == idx.count(q[i].first);
+
+    printf("  %-34s %9.3f ms/query\n", "linear scan per query", t_naive / max(naive_q, 1));
+    printf("  %-34s %9.3f us/query%s\n", "index covered + count", t_idx * 1000 / max(qs, 1), bench::check(ok));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 10000000;
+        int k = argc >= 4 ? atoi(argv[3]) : 16;
+        int qs = argc >= 5 ? atoi(argv[4]) : 1000000;
+        benchmark(n, k, qs);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "merge") == 0) {
+        vector<FILE*> runs;
+        for (int i = 3; i < argc; i++) {
+            FILE* f = fopen(argv[i], "rb");
+            if (!f) {
+                fprintf(stderr, "cannot open %s\n", argv[i]);
+                return 1;
+            }
+            runs.push_back(f);
+        }
+        FILE* out = fopen(argv[2], "wb");
+        if (!out) return 1;
+        vector<PII> buf;
+        buf.reserve(BLOCK);
+        merge_runs(runs, [&](int l, int r) {
+            buf.push_back({l, r});
+            if (buf.size() == BLOCK) fwrite(buf.data(), sizeof(PII), buf.size(), out), buf.clear();
+        });
+        fwrite(buf.data(), sizeof(PII), buf.size(), out);
+        fclose(out);
+        for (FILE* f : runs) fclose(f);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 803: 输入 5 / 1 2 / 2 4 / 5 6 / 7 8 / 7 9，输出 3
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<PII> segs(n);
+    for (auto& s : segs) cin >> s.first >> s.second;
+    cout << merge(segs).size() << endl;
+    return 0;
+}
@@ -0,0 +1,301 @@
+/*
+ * ============================================
+ *   败者树 k 路归并 - 流式输入 + 外部排序
+ *   基于 22_heap_sequence_merge.cpp (小根堆 + N 路归并)
+ *   题目来源: Luogu P1631 序列合并
+ * ============================================
+ *
+ * 【小根堆慢在哪】
+ *   每输出一个数：pop 一次 (下沉，每层比 2 次) + push 一次 (上浮)，约 2·log k 次比较，
+ *   还要把 {值, 行号} 这个 pair 在堆里来回搬。
+ *
+ * 【败者树 (Tournament Tree)】
+ *   k 个选手 (每路当前的队首) 站在叶子上，每个内部结点记录这场比赛的"败者"，
+ *   冠军 (全局最小) 单独记在 tree[0]：
+ *
+ *                     tree[0] = 冠军
+ *                         |
+ *                      [败者]            内部结点 1 .. k-1
+ *                    /        \
+ *                [败者]      [败者]
+ *                /    \      /    \
+ *              路0   路1   路2   路3     叶子 k .. 2k-1 (第 i 路在 k + i)
+ *
+ *   冠军被取走后，它那一路补上下一个数，只需从它的叶子往根走一遍：
+ *   每层和结点里存的败者比一次，输的留下、赢的继续往上。
+ *   一条路径 ceil(log k) 次比较，没有"和两个孩子都比"的开销，也不搬 pair。
+ *
+ * 【流式输入，不用哨兵】
+ *   每一路是一个 Source，只要求 bool next(T& x)：取下一个数，取完返回 false。
+ *   - RangeSource：一对迭代器 (内存里的有序段)；
+ *   - FileRun：    磁盘上的有序段，按块 fread 到缓冲区；
+ *   - 任何生成器：比如 P1631 的"第 i 行 A[i] + B[j]"。
+ *   教科书写法是给取完的路塞一个 +∞ 哨兵，但 T 不一定有"最大值"(字符串、结构体)。
+ *   这里每个结点带一个 alive 标记，比较时"已取完"的一律算输，取完的路不再读。
+ *   结点直接存败者的值和路号 (不只是路号)，重赛时沿路径顺序读，不再间接查每路的队首。
+ *   值相同时下标小的路赢，所以归并是稳定的。
+ *
+ * 【外部排序】
+ *   数据比内存大时：
+ *   1. 切段：每次读 mem 个数，排好序写进一个临时文件 (一个有序段 run)；
+ *   2. 归并：所有 run 各开一个 FileRun，用败者树一趟归并写到输出文件。
+ *   run 太多时 (超过 MAX_FANIN) 先分组归并成更长的 run，再继续。
+ *   每个 FileRun 的缓冲区是 mem / (路数 + 1)，总内存始终不超过 mem 个数。
+ *   磁盘满、短写、读出错 (fwrite / fread / fclose 任何一步) 都让 external_sort 返回 false，
+ *   不会留下一个"看起来成功"的截断文件；中途返回时输入和临时 run 都由 OpenFiles 关掉。
+ *
+ * 【复杂度】
+ *   - 归并 N 个数：O(N log k) 次比较，每个数恰好一条路径
+ *   - 外部排序：切段 O(N log mem)，归并 O(N log k)，磁盘读写约 2 遍 (run 不超过 MAX_FANIN 时)
+ *
+ * 【用法】
+ *   ./a.out                           P1631：读入 n、A、B，输出最小的 n 个和
+ *   ./a.out sort <输入> <输出> [内存元素数]   外部排序二进制 int32 文件
+ *   ./a.out bench [n]                 内存归并对比 priority_queue + 外部排序演示
+ *   败者树和 FileRun / FileWriter 放在共用头文件 ../loser_tree.h
+ *   编译: g++ -std=c++17 -O2 22_heap_sequence_merge_loser_tree.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../loser_tree.h"
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef pair<int, int> PII;
+
+// ========== 败者树 / 数据源 ==========
+// LoserTree、RangeSource、FileRun、FileWriter 在 ../loser_tree.h (21 的区间 run 归并也用它)
+using kway::FileRun;
+using kway::FileWriter;
+using kway::LoserTree;
+using kway::RangeSource;
+
+// 持有一组 FILE*，出作用域时全部关掉 (tmpfile 关闭即删除)；置成 nullptr 表示所有权已经交出去了
+struct OpenFiles {
+    vector<FILE*> v;
+    OpenFiles() = default;
+    OpenFiles(const OpenFiles&) = delete;
+    OpenFiles& operator=(const OpenFiles&) = delete;
+    ~OpenFiles() {
+        for (FILE* f : v)
+            if (f) fclose(f);
+    }
+};
+
+// ========== 外部排序 ==========
+const int MAX_FANIN = 256; // 一趟最多同时归并多少个 run (受打开文件数和缓冲区大小限制)
+
+// 把 runs 合并成一个有序流写到 out，runs 里的文件用完即关闭 (成功失败都关)；
+// 读写都没出错返回 true
+template <class T>
+bool merge_runs(vector<FILE*>& runs, FILE* out, size_t mem) {
+    size_t block = mem / (runs.size() + 1);
+    bool ok = true;
+    {
+        vector<FileRun<T>> src;
+        for (FILE* f : runs) {
+            rewind(f);
+            src.emplace_back(f, block);
+        }
+        LoserTree<T, FileRun<T>> lt(src);
+        FileWriter<T> w(out, block);
+        T x;
+        while (lt.pop(x) && w.ok) w.put(x);
+        ok = w.flush() && fflush(out) == 0 && !ferror(out);
+    }
+    for (FILE* f : runs) {
+        ok = ok && !ferror(f); // fread 出错和读完一样返回 0，要单独查
+        fclose(f);
+    }
+    runs.clear();
+    return ok;
+}
+
+// ⚡ 排序二进制文件 in -> out，内存里同时最多放 mem 个 T。
+// 任何一步读写失败都返回 false，已经打开的输入和临时 run 都会关掉
+template <class T>
+bool external_sort(const char* in_path, const char* out_path, size_t mem) {
+    mem = max<size_t>(mem, 2 * MAX_FANIN);
+    OpenFiles runs;
+
+    // 1. 切段：读 mem 个 -> 排序 -> 写临时文件
+    {
+        OpenFiles in;
+        FILE* fin = fopen(in_path, "rb");
+        if (!fin) return false;
+        in.v.push_back(fin);
+        vector<T> chunk(mem);
+        size_t got;
+        while ((got = fread(chunk.data(), sizeof(T), mem, fin)) > 0) {
+            sort(chunk.begin(), chunk.begin() + got);
+            FILE* f = tmpfile();
+            if (!f) return false;
+            runs.v.push_back(f);
+            if (fwrite(chunk.data(), sizeof(T), got, f) != got || fflush(f) != 0) return false;
+        }
+        if (ferror(fin)) return false;
+    }
+
+    // 2. run 太多就分组归并成更长的 run
+    while (runs.v.size() > (size_t)MAX_FANIN) {
+        OpenFiles next;
+        for (size_t i = 0; i < runs.v.size(); i += MAX_FANIN) {
+            FILE* f = tmpfile();
+            if (!f) return false;
+            next.v.push_back(f);
+            auto lo = runs.v.begin() + i, hi = runs.v.begin() + min(runs.v.size(), i + MAX_FANIN);
+            vector<FILE*> group(lo, hi);
+            fill(lo, hi, nullptr); // 交给 merge_runs 关
+            if (!merge_runs<T>(group, f, mem)) return false;
+        }
+        runs.v.swap(next.v);
+    }
+
+    // 3. 最后一趟直接写到输出
+    FILE* out = fopen(out_path, "wb");
+    if (!out) return false;
+    bool ok = merge_runs<T>(runs.v, out, mem);
+    return fclose(out) == 0 && ok;
+}
+
+// ========== P1631：第 i 行 A[i] + B[j] 作为一路 ==========
+struct RowSource {
+    int ai;
+    const int* b;
+    int j, n;
+    bool next(int& x) {
+        if (j == n) return false;
+        x = ai + b[j++];
+        return true;
+    }
+};
+
+vector<int> smallest_sums(const vector<int>& a, const vector<int>& b) {
+    int n = a.size();
+    vector<RowSource> rows;
+    for (int i = 0; i < n; i++) rows.push_back({a[i], b.data(), 0, n});
+    LoserTree<int, RowSource> lt(rows);
+    vector<int> res(n);
+    for (int i = 0; i < n; i++) lt.pop(res[i]);
+    return res;
+}
+
+// ========== 基准测试 ==========
+void bench_memory(int n, int k, mt19937& rng) {
+    vector<int> a(n);
+    for (auto& x : a) x = (int)rng();
+    vector<int> bounds(k + 1);
+    for (int i = 0; i <= k; i++) bounds[i] = (LL)n * i / k;
+    for (int i = 0; i < k; i++) sort(a.begin() + bounds[i], a.begin() + bounds[i + 1]);
+    vector<int> ref(a);
+    sort(ref.begin(), ref.end());
+
+    // 原版：priority_queue<{值, 路号}>
+    vector<int> out;
+    out.reserve(n);
+    auto st = chrono::steady_clock::now();
+    {
+        priority_queue<PII, vector<PII>, greater<PII>> q;
+        vector<int> pos(bounds.begin(), bounds.end() - 1);
+        for (int i = 0; i < k; i++)
+            if (pos[i] < bounds[i + 1]) q.push({a[pos[i]++], i});
+        while (!q.empty()) {
+            auto t = q.top();
+            q.pop();
+            out.push_back(t.first);
+            int i = t.second;
+            if (pos[i] < bounds[i + 1]) q.push({a[pos[i]++], i});
+        }
+    }
+    double t_heap = bench::elapsed_ms(st);
+    bool ok1 = out == ref;
+
+    out.clear();
+    st = chrono::steady_clock::now();
+    {
+        typedef RangeSource<vector<int>::const_iterator> Src;
+        vector<Src> src;
+        for (int i = 0; i < k; i++) src.push_back({a.cbegin() + bounds[i], a.cbegin() + bounds[i + 1]});
+        LoserTree<int, Src> lt(src);
+        int x;
+        while (lt.pop(x)) out.push_back(x);
+    }
+    double t_lt = bench::elapsed_ms(st);
+    bool ok2 = out == ref;
+
+    printf("  k = %-5d priority_queue %8.1f ms%s   loser tree %8.1f ms%s   x%.2f\n", k, t_heap,
+           bench::check(ok1), t_lt, bench::check(ok2), t_heap / t_lt);
+}
+
+void bench_external(int n, size_t mem) {
+    mt19937 rng(20260111);
+    const char* in_path = "/tmp/loser_tree_in.bin";
+    const char* out_path = "/tmp/loser_tree_out.bin";
+    vector<int> a(n);
+    for (auto& x : a) x = (int)rng();
+    FILE* f = fopen(in_path, "wb");
+    if (!f) return;
+    fwrite(a.data(), sizeof(int), n, f);
+    fclose(f);
+
+    auto st = chrono::steady_clock::now();
+    bool ok = external_sort<int>(in_path, out_path, mem);
+    double ms = bench::elapsed_ms(st);
+
+    sort(a.begin(), a.end());
+    vector<int> got(n);
+    f = fopen(out_path, "rb");
+    ok = ok && f && fread(got.data(), sizeof(int), n, f) == (size_t)n;
+    if (f) fclose(f);
+    ok = ok && got == a;
+    remove(in_path);
+    remove(out_path);
+    printf("  external sort %d ints, memory %zu ints (%zu runs): %.1f ms%s\n", n, mem, (n + mem - 1) / mem, ms,
+           bench::check(ok));
+}
+
+void benchmark(int n) {
+    mt19937 rng(20260111);
+    printf("in-memory merge of n = %d ints split into k sorted runs\n", n);
+    for (int k : {4, 16, 64, 256, 1024}) bench_memory(n, k, rng);
+    bench_external(n, n / 16);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        benchmark(argc >= 3 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "sort") == 0) {
+        size_t mem = argc >= 5 ? atoll(argv[4]) : (size_t)1 << 26; // 默认 64M 个 int = 256MB
+        if (!external_sort<int>(argv[2], argv[3], mem)) {
+            fprintf(stderr, "external sort failed\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // P1631: 输入 3 / 2 6 6 / 1 4 8，输出 3 6 7
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<int> a(n), b(n);
+    for (auto& x : a) cin >> x;
+    for (auto& x : b) cin >> x;
+
+    auto res = smallest_sums(a, b);
+    for (int i = 0; i < n; i++) cout << res[i] << (i + 1 < n ? " " : "\n");
+    return 0;
+}
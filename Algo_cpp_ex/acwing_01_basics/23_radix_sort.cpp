@@ -0,0 +1,209 @@
+/*
+ * ============================================
+ *   LSD 基数排序 (Radix Sort) - 不做比较的排序
+ *   服务对象: 20_discretization.cpp (坐标 sort + unique)
+ *             13_kruskal.cpp        (边按权重排序)
+ *             21_interval_merge.cpp (PII 区间按左端点排序)
+ * ============================================
+ *
+ * 【为什么能比 std::sort 快】
+ *   比较排序的下界是 O(N log N)：10^7 个数要比较约 2.3*10^8 次，而且分支难预测。
+ *   基数排序按"字节"分桶，32 位整数只需 4 趟顺序扫描，O(4N)，没有一次比较。
+ *
+ * 【LSD (Least Significant Digit) 流程】
+ *   每个键拆成 4 个字节 (64 位是 8 个)，从最低字节开始，每趟按当前字节稳定地分到 256 个桶：
+ *
+ *     原始:        0x0302  0x0101  0x0201  0x0102
+ *     按低字节:    0x0101  0x0201  0x0302  0x0102   (低字节 01 01 02 02)
+ *     按高字节:    0x0101  0x0102  0x0201  0x0302   (高字节 01 01 02 03) -> 有序
+ *
+ *   关键是"稳定"：高字节相同的元素，保持上一趟按低字节排好的相对顺序。
+ *
+ * 【三个工程细节】
+ *   1. 一次扫描建全部直方图：cnt[b][v] = 第 b 个字节等于 v 的个数，
+ *      4 个字节的直方图在同一趟里一起数完，之后每趟只剩"分发"。
+ *   2. 跳过无用趟：如果某个字节所有元素都一样 (cnt[b][v] == n)，这一趟什么都不会变，直接跳过。
+ *      坐标都在 [0, 10^5] 时高字节全是 0，32 位排序实际只跑 3 趟。
+ *   3. 有符号数：补码里负数的最高位是 1，按无符号比会排到正数后面。
+ *      把符号位翻转一下 (x ^ 0x80000000) 就变成了保序的无符号数：
+ *        -2^31 -> 0x00000000,  -1 -> 0x7FFFFFFF,  0 -> 0x80000000,  2^31-1 -> 0xFFFFFFFF
+ *
+ * 【(键, 载荷) 记录】
+ *   radix_sort_by_key(a, n, key) 只要求 key(x) 返回 uint32_t / uint64_t，整条记录跟着键一起搬：
+ *   - PII 按 (first, second) 字典序：key = (翻转后的 first) << 32 | (翻转后的 second)
+ *   - Kruskal 的 Edge 按 w：key = 翻转后的 w
+ *   因为是稳定排序，权重相同的边保持输入顺序 (std::sort 不保证，但 MST 总权重不受影响)。
+ *
+ * 【复杂度】
+ *   - 时间：O(N * 字节数)，32 位 4 趟，64 位 8 趟 (可被跳过的趟不算)
+ *   - 空间：O(N) 乒乓缓冲 + O(256 * 字节数) 直方图
+ *
+ * 【用法】
+ *   ./a.out            三个调用点的替换示例
+ *   ./a.out bench [n]  n 个键上对比 std::sort
+ *   编译: g++ -std=c++17 -O2 23_radix_sort.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef pair<int, int> PII;
+
+// ========== 保序映射：有符号 -> 无符号 ==========
+inline uint32_t radix_key(int x) { return (uint32_t)x ^ 0x80000000u; }
+inline uint64_t radix_key(LL x) { return (uint64_t)x ^ 0x8000000000000000ull; }
+inline uint32_t radix_key(uint32_t x) { return x; }
+inline uint64_t radix_key(uint64_t x) { return x; }
+inline uint64_t radix_key(const PII& p) {
+    return (uint64_t)radix_key(p.first) << 32 | radix_key(p.second);
+}
+
+// ⚡ 核心模板：按 key(x) 的无符号值稳定排序 a[0, n)
+template <class T, class KeyFn>
+void radix_sort_by_key(T* a, int n, KeyFn key) {
+    typedef typename decay<decltype(key(a[0]))>::type U;
+    static_assert(is_unsigned<U>::value, "key 必须返回无符号整数");
+    const int BYTES = sizeof(U);
+    if (n <= 1) return;
+
+    // 1. 一趟扫描，数出所有字节的直方图
+    vector<int> cnt(BYTES * 256, 0);
+    for (int i = 0; i < n; i++) {
+        U k = key(a[i]);
+        for (int b = 0; b < BYTES; b++) cnt[b * 256 + (k >> (8 * b) & 255)]++;
+    }
+
+    // 2. 从低到高逐字节分发，src / dst 乒乓
+    vector<T> buf(n);
+    T* src = a;
+    T* dst = buf.data();
+    U first = key(a[0]);
+    for (int b = 0; b < BYTES; b++) {
+        int* c = &cnt[b * 256];
+        if (c[first >> (8 * b) & 255] == n) continue; // 这个字节全都一样，跳过
+
+        // 计数 -> 桶起点 (前缀和)
+        int sum = 0;
+        for (int v = 0; v < 256; v++) {
+            int t = c[v];
+            c[v] = sum;
+            sum += t;
+        }
+        for (int i = 0; i < n; i++) {
+            U k = key(src[i]);
+            dst[c[k >> (8 * b) & 255]++] = std::move(src[i]);
+        }
+        swap(src, dst);
+    }
+
+    // 3. 结果在 buf 里就搬回去
+    if (src != a) move(src, src + n, a);
+}
+
+// 常用类型的快捷入口：int / LL / uint32_t / uint64_t / PII
+template <class T>
+void radix_sort(T* a, int n) {
+    radix_sort_by_key(a, n, [](const T& x) { return radix_key(x); });
+}
+
+template <class T>
+void radix_sort(vector<T>& a) { radix_sort(a.data(), (int)a.size()); }
+
+// ========== 调用点示例 ==========
+
+// 13_kruskal.cpp 的边
+struct Edge {
+    int a, b, w;
+    bool operator< (const Edge& W) const { return w < W.w; }
+};
+
+void demo() {
+    // 1. 20_discretization.cpp: sort(alls) + unique(alls)
+    vector<int> alls = {1000000, 5, -234567, 5, 8, -1};
+    radix_sort(alls); // 原: sort(alls.begin(), alls.end());
+    alls.erase(unique(alls.begin(), alls.end()), alls.end());
+    cout << "离散化坐标: ";
+    for (int x : alls) cout << x << " ";
+    cout << endl;
+
+    // 2. 13_kruskal.cpp: sort(edges, edges + m)
+    Edge edges[] = {{1, 2, 5}, {2, 3, -3}, {1, 3, 2}, {3, 4, 2}};
+    int m = 4;
+    // 原: sort(edges, edges + m);
+    radix_sort_by_key(edges, m, [](const Edge& e) { return radix_key(e.w); });
+    cout << "Kruskal 边: ";
+    for (int i = 0; i < m; i++) cout << "(" << edges[i].a << "," << edges[i].b << "," << edges[i].w << ") ";
+    cout << endl;
+
+    // 3. 21_interval_merge.cpp: sort(segs.begin(), segs.end())
+    vector<PII> segs = {{2, 4}, {-5, 1}, {2, 3}, {7, 8}};
+    radix_sort(segs); // 原: sort(segs.begin(), segs.end());
+    cout << "区间: ";
+    for (auto& s : segs) cout << "[" << s.first << "," << s.second << "] ";
+    cout << endl;
+}
+
+// ========== 基准测试 ==========
+template <class T, class Sort>
+double time_it(vector<T> a, Sort sorter, vector<T>* out) {
+    auto st = chrono::steady_clock::now();
+    sorter(a);
+    double ms = bench::elapsed_ms(st);
+    if (out) *out = move(a);
+    return ms;
+}
+
+template <class T, class Radix>
+void compare(const char* name, const vector<T>& base, Radix radix) {
+    vector<T> ref, got;
+    double t1 = time_it(base, [](vector<T>& a) { sort(a.begin(), a.end()); }, &ref);
+    double t2 = time_it(base, radix, &got);
+    bool ok = ref.size() == got.size();
+    for (size_t i = 0; ok && i < ref.size(); i++) ok = !(ref[i] < got[i]) && !(got[i] < ref[i]);
+    printf("  %-18s std::sort %9.1f ms   radix %9.1f ms   x%.1f%s\n", name, t1, t2, t1 / t2, bench::check(ok));
+}
+
+void benchmark(int n) {
+    mt19937_64 rng(20260103);
+    cout << "n = " << n << endl;
+
+    vector<int> a32(n);
+    for (auto& x : a32) x = (int)rng();
+    compare("int (random)", a32, [](vector<int>& a) { radix_sort(a); });
+
+    for (auto& x : a32) x = rng() % 100000;
+    compare("int [0, 1e5)", a32, [](vector<int>& a) { radix_sort(a); });
+
+    vector<LL> a64(n);
+    for (auto& x : a64) x = (LL)rng();
+    compare("long long", a64, [](vector<LL>& a) { radix_sort(a); });
+
+    vector<PII> ps(n);
+    for (auto& p : ps) p = {(int)(rng() % 2000000000) - 1000000000, (int)rng()};
+    compare("PII", ps, [](vector<PII>& a) { radix_sort(a); });
+
+    vector<Edge> es(n);
+    for (auto& e : es) e = {(int)(rng() % n), (int)(rng() % n), (int)(rng() % 2000001) - 1000000};
+    compare("Edge by w", es, [](vector<Edge>& a) {
+        radix_sort_by_key(a.data(), (int)a.size(), [](const Edge& e) { return radix_key(e.w); });
+    });
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        benchmark(argc >= 3 ? atoi(argv[2]) : 10000000);
+        return 0;
+    }
+    demo();
+    return 0;
+}
@@ -0,0 +1,882 @@
+/*
+ * ============================================
+ *   BigInt - 压位高精度 (10^9 进制) + Karatsuba 乘法
+ *   统一替代 05 ~ 08 的 add / sub / mul / div
+ * ============================================
+ *
+ * 【原版模板的问题】
+ *   05 ~ 08 的 vector<int> 每个 int 只存一位十进制数 (0 ~ 9)：
+ *   - 一个 int 有 32 位，只用了不到 4 位，内存浪费约 9 倍；
+ *   - 100 万位的数要做 100 万次进位，压位后只要 11 万次；
+ *   - 每次运算都 return 一个新 vector，A = add(A, B) 要整段拷贝；
+ *   - 只能处理非负数，A - B 还得先 cmp 再决定谁减谁。
+ *
+ * 【压位：一个 int 存 9 位十进制】
+ *   BASE = 10^9，d[0] 是最低的 9 位 (小端，和原版"倒序存储"一个习惯)：
+ *
+ *     12345678901234567890
+ *     = 12 | 345678901 | 234567890
+ *     d = [234567890, 345678901, 12]
+ *
+ *   为什么是 10^9 而不是 2^32？
+ *   - 两个 limb 相乘 < 10^18 < 2^63，unsigned long long 装得下，还能再累加十几次；
+ *   - 输入输出是十进制，10^9 进制下每个 limb 正好对应 9 个字符，转换是线性的。
+ *
+ * 【符号】
+ *   neg + 绝对值 d。0 统一表示成 d 为空、neg = false，所以不会有 "-0"。
+ *   加减法先看符号：同号 -> 绝对值相加；异号 -> 大的绝对值减小的，符号跟大的走。
+ *
+ * 【原地运算 + 移动语义】
+ *   a += b 直接在 a.d 上进位，不产生新 vector；
+ *   a + b 写成 operator+(BigInt a, const BigInt& b)：参数按值传入，
+ *   调用方传临时量时直接"搬"进来 (move)，整条表达式 a + b + c 只有一次拷贝。
+ *
+ * 【乘法：小的用竖式，大的用 Karatsuba】
+ *   1. 竖式 (schoolbook)：和 07_high_precision_mul_AB.cpp 一样是卷积 c[i+j] += a[i]*b[j]，
+ *      但用 unsigned long long 累加，每 16 行才统一进位一次 (16 * 10^18 < 2^64)，
+ *      内层循环只剩一次乘加，没有除法。外层走短的一方，进位只扫这 16 行写过的窗口，
+ *      长 x 短 (例如 10^6 位 x 几百位) 仍是 O(na * nb)。
+ *   2. Karatsuba：把 A、B 各切成高低两半 (m 个 limb)：
+ *        A = a1 * BASE^m + a0,   B = b1 * BASE^m + b0
+ *        z0 = a0 * b0,  z2 = a1 * b1
+ *        z1 = (a0 + a1)(b0 + b1) - z0 - z2      <- 3 次乘法代替 4 次
+ *        A * B = z2 * BASE^2m + z1 * BASE^m + z0
+ *      T(n) = 3T(n/2) + O(n) = O(n^log2(3)) ≈ O(n^1.585)
+ *   3. 两数长度悬殊 (2|B| <= |A|) 时，把 A 按 |B| 切片逐段相乘再错位相加，避免 Karatsuba 空转。
+ *   KARATSUBA_THRESHOLD = 64 个 limb 以下走竖式，是 bench 模式下 10^4 ~ 10^6 位实测的拐点。
+ *
+ * 【除法：大数除以大数】
+ *   08 的 div(A, b, r) 只能除 int。大数除大数分两档：
+ *   1. Knuth Algorithm D (竖式长除法的 limb 版)：
+ *      - 规格化：被除数、除数同乘 f = BASE / (除数最高 limb + 1)，让除数最高 limb >= BASE/2；
+ *      - 每一步用"被除数最高两个 limb / 除数最高 limb"试商 qhat，再用次高 limb 修正，
+ *        规格化保证 qhat 最多偏大 2，最后减成负数的概率约 2/BASE，加回一次即可；
+ *      - O(|商| * |除数|)，除数或商有一方较短时最快。
+ *   2. 牛顿迭代 (除数和商都 >= NEWTON_THRESHOLD 个 limb)：
+ *      - 先求倒数 x ≈ BASE^(2k) / t：x' = x + x * (BASE^(2k) - t*x) / BASE^(2k)，
+ *        每迭代一次有效位数翻倍，所以递归地"先求一半精度，再迭代一步"；
+ *      - 商 q ≈ (a * x) >> (k + n) 个 limb，最后算出余数 a - q*b，差几个单位就逐个修正；
+ *      - 总代价是常数次同规模乘法 O(M(n))，乘法走 Karatsuba 时就是 O(n^1.585)。
+ *
+ * 【十进制读写】
+ *   选 10^9 进制的另一半理由：一个 limb = 9 个字符，字符串 <-> BigInt 是 O(位数) 的直接切分，
+ *   2^32 进制要靠"分治 + 缓存的 10^9 的幂"才能做到次平方，这里完全省掉。剩下的是常数：
+ *   - 解析：8 个字符装进一个 ULL，三步乘加 (SWAR) 同时算出 8 位，再补上第 9 位；
+ *   - 输出：查 "00" ~ "99" 两位数字表，一次写两个字符；
+ *     operator<< 每攒满 64KB 就整块 write，百万位输出不再先拼一个完整 string。
+ *
+ * 【复杂度】
+ *   - 读写十进制：O(位数)
+ *   - 加减 / 乘除小整数：O(n)，n = 位数 / 9
+ *   - 大数乘法：O(n^1.585)
+ *   - 大数除法：Knuth D O(|商| * |除数|)；牛顿 O(n^1.585)
+ *
+ * 【用法】
+ *   ./a.out                  读入 A B，输出 A+B、A-B、A*B、A/B、A%B (支持负数)
+ *   ./a.out bench [最大位数]  在 10^4 ~ 10^6 位上对比原版 base-10 函数
+ *   编译: g++ -std=c++17 -O2 24_bigint.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef unsigned long long ULL;
+
+struct BigInt {
+    static const int BASE = 1000000000;
+    static const int WIDTH = 9;
+    static const int KARATSUBA_THRESHOLD = 64;
+    static const int NEWTON_THRESHOLD = 256; // 除数和商都不少于这么多 limb 才用牛顿除法
+    static const int NEWTON_BASE_LIMBS = 32; // 牛顿求倒数递归到这么短就直接 Knuth D
+
+    vector<int> d;    // 小端 limb，最高位 limb 非 0；0 表示为空
+    bool neg = false; // 负号
+
+    BigInt() {}
+    BigInt(LL x) {
+        ULL u = x < 0 ? 0ULL - (ULL)x : (ULL)x; // 用无符号取绝对值，LLONG_MIN 也不会溢出
+        neg = x < 0;
+        while (u) d.push_back((int)(u % BASE)), u /= BASE;
+    }
+    explicit BigInt(const string& s) { parse(s); }
+
+    bool is_zero() const { return d.empty(); }
+
+    // 去掉高位的 0 limb；结果为 0 时把符号也清掉
+    void trim() {
+        while (!d.empty() && d.back() == 0) d.pop_back();
+        if (d.empty()) neg = false;
+    }
+
+    // ========== 十进制字符串 <-> BigInt ==========
+    // 10^9 进制下每个 limb 正好对应 9 个十进制字符，转换天然是线性的：
+    // 不需要 2^32 进制那种"分治 + 缓存 10^9 的幂"的进制转换，瓶颈只剩逐字符的常数。
+    // 读：8 个字符一次装进 ULL，用 SWAR 三步乘加并行算出 8 位数；
+    // 写：查"两位数字表"一次写两个字符，攒满一块缓冲区就整块 write 出去，不拼整串。
+
+    // 把 8 个 ASCII 数字 (小端装入 ULL) 转成整数：相邻两位 -> 四位 -> 八位
+    static int parse8(const char* p) {
+        ULL v;
+        memcpy(&v, p, 8);
+        v -= 0x3030303030303030ULL;
+        v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFULL;
+        v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFULL;
+        v = (v * 10000 + (v >> 32)) & 0xFFFFFFFFULL;
+        return (int)v;
+    }
+
+    // 从末尾起每 9 个字符一组，恰好是一个 limb
+    void parse(const char* s, size_t len) {
+        d.clear();
+        neg = false;
+        size_t st = 0;
+        if (st < len && (s[st] == '-' || s[st] == '+')) neg = s[st++] == '-';
+        d.reserve((len - st) / WIDTH + 1);
+        size_t i = len;
+        for (; i >= st + WIDTH; i -= WIDTH) {
+            const char* p = s + i - WIDTH;
+            d.push_back((p[0] - '0') * 100000000 + parse8(p + 1));
+        }
+        if (i > st) { // 最高位不满 9 个字符的那一组
+            int x = 0;
+            for (size_t j = st; j < i; j++) x = x * 10 + (s[j] - '0');
+            d.push_back(x);
+        }
+        trim();
+    }
+    void parse(const string& s) { parse(s.data(), s.size()); }
+
+    static const char* digit_pairs() {
+        static const char table[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        return table;
+    }
+
+    // 写满 9 位 (中间的 limb 要保留前导零)
+    static char* put_limb9(char* p, int x) {
+        const char* t = digit_pairs();
+        p[0] = (char)('0' + x / 100000000);
+        x %= 100000000;
+        for (int k = 7; k > 0; k -= 2, x /= 100) memcpy(p + k, t + x % 100 * 2, 2);
+        return p + 9;
+    }
+
+    // 最高位 limb：不补前导零
+    static char* put_top(char* p, int x) {
+        char tmp[12];
+        char* e = put_limb9(tmp, x);
+        char* b = tmp;
+        while (b + 1 < e && *b == '0') b++;
+        memcpy(p, b, e - b);
+        return p + (e - b);
+    }
+
+    size_t decimal_length() const {
+        if (d.empty()) return 1;
+        char tmp[12];
+        return neg + (put_top(tmp, d.back()) - tmp) + (d.size() - 1) * WIDTH;
+    }
+
+    string to_string() const {
+        if (d.empty()) return "0";
+        string s(decimal_length(), '0');
+        char* p = &s[0];
+        if (neg) *p++ = '-';
+        p = put_top(p, d.back());
+        for (int i = (int)d.size() - 2; i >= 0; i--) p = put_limb9(p, d[i]);
+        return s;
+    }
+
+    // 流式输出：每攒满 64KB 写一次，百万位的数也不需要先拼成一整个 string
+    void write(ostream& os) const {
+        if (d.empty()) {
+            os.put('0');
+            return;
+        }
+        const int CHUNK = 1 << 16;
+        char buf[CHUNK + 32];
+        char* p = buf;
+        if (neg) *p++ = '-';
+        p = put_top(p, d.back());
+        for (int i = (int)d.size() - 2; i >= 0; i--) {
+            p = put_limb9(p, d[i]);
+            if (p - buf >= CHUNK) os.write(buf, p - buf), p = buf;
+        }
+        os.write(buf, p - buf);
+    }
+
+    // ========== 绝对值运算 (只看 limb，不管符号) ==========
+
+    // 比较 |a| 和 |b|：返回 -1 / 0 / 1
+    static int cmp_mag(const vector<int>& a, const vector<int>& b) {
+        if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+        for (int i = (int)a.size() - 1; i >= 0; i--)
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+
+    // a += b * BASE^shift
+    static void add_mag(vector<int>& a, const int* b, int nb, int shift = 0) {
+        if ((int)a.size() < nb + shift) a.resize(nb + shift, 0);
+        int carry = 0, i = 0;
+        for (; i < nb; i++) {
+            int t = a[i + shift] + b[i] + carry; // < 2 * 10^9 + 1 < 2^31
+            carry = t >= BASE;
+            a[i + shift] = carry ? t - BASE : t;
+        }
+        for (i += shift; carry && i < (int)a.size(); i++) {
+            carry = ++a[i] == BASE;
+            if (carry) a[i] = 0;
+        }
+        if (carry) a.push_back(1);
+    }
+    static void add_mag(vector<int>& a, const vector<int>& b, int shift = 0) {
+        add_mag(a, b.data(), (int)b.size(), shift);
+    }
+
+    // a -= b * BASE^shift，前提 |a| >= |b| * BASE^shift
+    static void sub_mag(vector<int>& a, const int* b, int nb, int shift = 0) {
+        int borrow = 0, i = 0;
+        for (; i < nb; i++) {
+            int t = a[i + shift] - b[i] - borrow;
+            borrow = t < 0;
+            a[i + shift] = borrow ? t + BASE : t;
+        }
+        for (i += shift; borrow && i < (int)a.size(); i++) {
+            borrow = --a[i] < 0;
+            if (borrow) a[i] += BASE;
+        }
+        while (!a.empty() && a.back() == 0) a.pop_back();
+    }
+    static void sub_mag(vector<int>& a, const vector<int>& b, int shift = 0) {
+        sub_mag(a, b.data(), (int)b.size(), shift);
+    }
+
+    // 竖式乘法：ULL 累加 16 行再统一进位
+    // 外层循环走短的一方：长 x 短时行数 = 短的长度，每 16 行只进位这 16 行碰过的窗口，
+    // 总代价 O(na * nb)；外层走长的一方、每次整段进位会退化成 O(na^2 / 16)
+    static vector<int> mul_school(const int* a, int na, const int* b, int nb) {
+        if (na > nb) swap(a, b), swap(na, nb);
+        vector<ULL> c(na + nb + 1, 0);
+        // 第 lo..i 行只写了 c[lo .. i+nb-1]，下面的已经规格化；进位到 0 为止
+        auto carry_from = [&](int lo, int hi) {
+            ULL carry = 0;
+            for (int k = lo; k < (int)c.size() && (k < hi || carry); k++) {
+                c[k] += carry;
+                carry = c[k] / BASE;
+                c[k] %= BASE;
+            }
+        };
+        for (int i = 0; i < na; i++) {
+            ULL x = a[i];
+            if (x) {
+                ULL* ci = c.data() + i;
+                for (int j = 0; j < nb; j++) ci[j] += x * (ULL)b[j];
+            }
+            if ((i & 15) == 15) carry_from(i - 15, i + nb);
+        }
+        carry_from(na & ~15, na + nb);
+        vector<int> res(c.begin(), c.end());
+        while (!res.empty() && res.back() == 0) res.pop_back();
+        return res;
+    }
+
+    // 大数乘法入口：按长度选择竖式 / 切片 / Karatsuba
+    static vector<int> mul_mag(const int* a, int na, const int* b, int nb) {
+        while (na && a[na - 1] == 0) na--;
+        while (nb && b[nb - 1] == 0) nb--;
+        if (na < nb) swap(a, b), swap(na, nb);
+        if (nb == 0) return {};
+        if (nb < KARATSUBA_THRESHOLD) return mul_school(a, na, b, nb);
+
+        // 长度悬殊：A 按 |B| 切片，每片和 B 做一次平衡的乘法
+        if (2 * nb <= na) {
+            vector<int> res;
+            for (int i = 0; i < na; i += nb) {
+                vector<int> p = mul_mag(a + i, min(nb, na - i), b, nb);
+                add_mag(res, p, i);
+            }
+            while (!res.empty() && res.back() == 0) res.pop_back();
+            return res;
+        }
+
+        // Karatsuba：这里 nb > na / 2 >= m，所以 b 的高半段一定非空
+        int m = na / 2;
+        vector<int> z0 = mul_mag(a, m, b, m);
+        vector<int> z2 = mul_mag(a + m, na - m, b + m, nb - m);
+        vector<int> sa(a, a + m), sb(b, b + m);
+        add_mag(sa, a + m, na - m);
+        add_mag(sb, b + m, nb - m);
+        vector<int> z1 = mul_mag(sa.data(), (int)sa.size(), sb.data(), (int)sb.size());
+        sub_mag(z1, z0);
+        sub_mag(z1, z2);
+
+        vector<int> res(z0);
+        res.reserve(na + nb + 1);
+        add_mag(res, z1, m);
+        add_mag(res, z2, 2 * m);
+        while (!res.empty() && res.back() == 0) res.pop_back();
+        return res;
+    }
+    static vector<int> mul_mag(const vector<int>& a, const vector<int>& b) {
+        return mul_mag(a.data(), (int)a.size(), b.data(), (int)b.size());
+    }
+
+    // ========== 带符号的原地运算 ==========
+
+    // *this += (oneg ? -|o| : |o|)
+    void add_signed(const BigInt& o, bool oneg) {
+        if (neg == oneg) add_mag(d, o.d);
+        else if (cmp_mag(d, o.d) >= 0) sub_mag(d, o.d);
+        else {
+            vector<int> t = o.d; // |o| > |this|：反过来减，符号跟 o 走
+            sub_mag(t, d);
+            d.swap(t);
+            neg = oneg;
+        }
+        trim();
+    }
+
+    BigInt& operator+=(const BigInt& o) { add_signed(o, o.neg); return *this; }
+    BigInt& operator-=(const BigInt& o) { add_signed(o, !o.neg); return *this; }
+
+    BigInt& operator*=(const BigInt& o) {
+        d = mul_mag(d, o.d);
+        neg = neg != o.neg;
+        trim();
+        return *this;
+    }
+
+    // 乘小整数 (|b| < 2^31)：对应 07 的 mul(A, b)
+    BigInt& operator*=(int b) {
+        if (b < 0) neg = !neg, b = -b;
+        ULL carry = 0;
+        for (auto& x : d) {
+            ULL t = (ULL)x * b + carry;
+            x = (int)(t % BASE);
+            carry = t / BASE;
+        }
+        while (carry) d.push_back((int)(carry % BASE)), carry /= BASE;
+        trim();
+        return *this;
+    }
+
+    // 除以小整数 (0 < |b| < 2^31)，返回余数：对应 08 的 div(A, b, r)
+    // 向零取整，余数和被除数同号 (与 C++ 的 / 和 % 一致)
+    int divmod_small(int b) {
+        bool rneg = neg;
+        ULL ub = b < 0 ? 0ULL - (ULL)(LL)b : (ULL)b;
+        if (b < 0) neg = !neg;
+        ULL r = 0;
+        for (int i = (int)d.size() - 1; i >= 0; i--) {
+            ULL cur = r * BASE + d[i];
+            d[i] = (int)(cur / ub);
+            r = cur % ub;
+        }
+        trim();
+        return rneg ? -(int)r : (int)r;
+    }
+    BigInt& operator/=(int b) { divmod_small(b); return *this; }
+
+    // ========== 大数除以大数 ==========
+
+    // |a| / b (0 < b < BASE)，余数写进 r
+    static vector<int> div_small_mag(const vector<int>& a, int b, int& r) {
+        vector<int> q(a.size());
+        LL cur = 0;
+        for (int i = (int)a.size() - 1; i >= 0; i--) {
+            cur = cur * BASE + a[i];
+            q[i] = (int)(cur / b);
+            cur %= b;
+        }
+        r = (int)cur;
+        while (!q.empty() && q.back() == 0) q.pop_back();
+        return q;
+    }
+
+    // Knuth Algorithm D：|a| / |b|，要求 |b| >= 2 个 limb 且 |a| >= |b|
+    static vector<int> divmod_knuth(const vector<int>& a, const vector<int>& b, vector<int>& rem) {
+        int n = (int)b.size(), m = (int)a.size() - n;
+        // 1. 规格化：u, v 同乘 f，使除数最高 limb >= BASE / 2，试商最多偏大 2
+        int f = BASE / (b.back() + 1);
+        vector<int> u = a, v = b;
+        BigInt tu, tv;
+        tu.d.swap(u), tv.d.swap(v);
+        tu *= f, tv *= f;
+        u.swap(tu.d), v.swap(tv.d);
+        u.resize(a.size() + 1, 0);
+
+        vector<int> q(m + 1, 0);
+        for (int j = m; j >= 0; j--) {
+            // 2. 试商：用被除数的最高两个 limb 除以除数的最高 limb，再用次高 limb 修正
+            LL num = (LL)u[j + n] * BASE + u[j + n - 1];
+            LL qhat = num / v[n - 1], rhat = num % v[n - 1];
+            while (qhat >= BASE || qhat * v[n - 2] > rhat * BASE + u[j + n - 2]) {
+                qhat--;
+                rhat += v[n - 1];
+                if (rhat >= BASE) break;
+            }
+            // 3. u[j .. j+n] -= qhat * v
+            LL carry = 0, borrow = 0;
+            for (int i = 0; i < n; i++) {
+                LL p = qhat * v[i] + carry;
+                carry = p / BASE;
+                LL t = u[i + j] - p % BASE - borrow;
+                borrow = t < 0;
+                u[i + j] = (int)(borrow ? t + BASE : t);
+            }
+            LL t = u[j + n] - carry - borrow;
+            // 4. 减成负数说明 qhat 大了 1 (概率约 2/BASE)：加回一个 v
+            if (t < 0) {
+                qhat--;
+                LL c = 0;
+                for (int i = 0; i < n; i++) {
+                    LL sum = (LL)u[i + j] + v[i] + c;
+                    c = sum >= BASE;
+                    u[i + j] = (int)(c ? sum - BASE : sum);
+                }
+                t += c;
+            }
+            u[j + n] = (int)t;
+            q[j] = (int)qhat;
+        }
+        // 5. 余数要除回规格化因子
+        u.resize(n);
+        while (!u.empty() && u.back() == 0) u.pop_back();
+        int dummy;
+        rem = div_small_mag(u, f, dummy);
+        while (!q.empty() && q.back() == 0) q.pop_back();
+        return q;
+    }
+
+    // 乘 / 除 BASE^s：整 limb 平移
+    static vector<int> shift_left(const vector<int>& a, int s) {
+        if (a.empty()) return a;
+        vector<int> r(s, 0);
+        r.insert(r.end(), a.begin(), a.end());
+        return r;
+    }
+    static vector<int> shift_right(const vector<int>& a, int s) {
+        if (s >= (int)a.size()) return {};
+        return vector<int>(a.begin() + s, a.end());
+    }
+
+    // 牛顿迭代求倒数：返回 floor(BASE^(2k) / t)，k = |t|，结果精确
+    // 先递归求 t 的高 k' = k/2 + 2 个 limb 的倒数 (多 2 个 limb 当保护位)，
+    // 放大到 k 位精度后做一步 x = x + x * (BASE^2k - t*x) / BASE^2k，有效位数翻倍，
+    // 最后用 t*x 和 BASE^2k 的差把 x 校正成精确的 floor (只差几个单位，循环很短)。
+    static vector<int> reciprocal(const vector<int>& t) {
+        int k = (int)t.size();
+        vector<int> one = {1};
+        vector<int> full = shift_left(one, 2 * k); // BASE^(2k)
+        if (k <= NEWTON_BASE_LIMBS) {
+            vector<int> r;
+            return divmod_knuth(full, t, r);
+        }
+        int kk = k / 2 + 2, h = k - kk;
+        vector<int> x = shift_left(reciprocal(shift_right(t, h)), h);
+
+        vector<int> p = mul_mag(t, x);
+        if (cmp_mag(p, full) <= 0) {
+            vector<int> e = full;
+            sub_mag(e, p);
+            add_mag(x, shift_right(mul_mag(x, e), 2 * k));
+        } else {
+            sub_mag(p, full);
+            sub_mag(x, shift_right(mul_mag(x, p), 2 * k));
+        }
+
+        // 校正：要求 t*x <= BASE^2k < t*(x+1)
+        p = mul_mag(t, x);
+        while (cmp_mag(p, full) > 0) sub_mag(x, one), sub_mag(p, t);
+        vector<int> e = full;
+        sub_mag(e, p);
+        while (cmp_mag(e, t) >= 0) add_mag(x, one), sub_mag(e, t);
+        return x;
+    }
+
+    // 牛顿除法：用 k = |q| + 2 位精度的倒数把除法变成一次乘法，再精确校正余数
+    static vector<int> divmod_newton(const vector<int>& a, const vector<int>& b, vector<int>& rem) {
+        int n = (int)b.size(), m = (int)a.size();
+        int k = m - n + 3;
+        // t = b * BASE^(k-n)：k > n 时低位补 0，k < n 时只取 b 的高 k 个 limb
+        vector<int> t = k >= n ? shift_left(b, k - n) : shift_right(b, n - k);
+        // a 的低 n-2 个 limb 对商的贡献 < BASE^-1，直接丢掉，乘法规模从 |a| 降到 |q|
+        int s = n - 2;
+        vector<int> q = shift_right(mul_mag(shift_right(a, s), reciprocal(t)), k + n - s);
+
+        // 余数 = a - q*b，q 可能差几个单位，逐个修正
+        vector<int> one = {1};
+        vector<int> p = mul_mag(q, b);
+        while (cmp_mag(p, a) > 0) sub_mag(q, one), sub_mag(p, b);
+        rem = a;
+        sub_mag(rem, p);
+        while (cmp_mag(rem, b) >= 0) add_mag(q, one), sub_mag(rem, b);
+        return q;
+    }
+
+    // |a| / |b| 的分发：单 limb 除数 -> 短除；一边较短 -> Knuth D；两边都长 -> 牛顿
+    static vector<int> divmod_mag(const vector<int>& a, const vector<int>& b, vector<int>& rem) {
+        if (cmp_mag(a, b) < 0) {
+            rem = a;
+            return {};
+        }
+        if (b.size() == 1) {
+            int r;
+            vector<int> q = div_small_mag(a, b[0], r);
+            rem.clear();
+            if (r) rem.push_back(r);
+            return q;
+        }
+        int n = (int)b.size(), m = (int)a.size();
+        if (n < NEWTON_THRESHOLD || m - n < NEWTON_THRESHOLD) return divmod_knuth(a, b, rem);
+        return divmod_newton(a, b, rem);
+    }
+
+    // 带符号除法 (b != 0)：向零取整，余数与被除数同号，和 C++ 的 / % 一致
+    static BigInt divmod(const BigInt& a, const BigInt& b, BigInt& r) {
+        BigInt q;
+        q.d = divmod_mag(a.d, b.d, r.d);
+        q.neg = a.neg != b.neg;
+        r.neg = a.neg;
+        q.trim();
+        r.trim();
+        return q;
+    }
+
+    BigInt& operator/=(const BigInt& o) {
+        BigInt r;
+        *this = divmod(*this, o, r);
+        return *this;
+    }
+    BigInt& operator%=(const BigInt& o) {
+        BigInt r;
+        divmod(*this, o, r);
+        *this = move(r);
+        return *this;
+    }
+
+    BigInt operator-() const {
+        BigInt r = *this;
+        if (!r.is_zero()) r.neg = !r.neg;
+        return r;
+    }
+
+    // 带符号比较
+    static int cmp(const BigInt& a, const BigInt& b) {
+        if (a.neg != b.neg) return a.neg ? -1 : 1;
+        int c = cmp_mag(a.d, b.d);
+        return a.neg ? -c : c;
+    }
+};
+
+// 按值接收左操作数：传临时量时直接移动，不拷贝
+BigInt operator+(BigInt a, const BigInt& b) { a += b; return a; }
+BigInt operator-(BigInt a, const BigInt& b) { a -= b; return a; }
+BigInt operator*(const BigInt& a, const BigInt& b) { BigInt r = a; r *= b; return r; }
+BigInt operator*(BigInt a, int b) { a *= b; return a; }
+BigInt operator/(BigInt a, int b) { a /= b; return a; }
+BigInt operator/(BigInt a, const BigInt& b) { a /= b; return a; }
+BigInt operator%(BigInt a, const BigInt& b) { a %= b; return a; }
+
+bool operator==(const BigInt& a, const BigInt& b) { return a.neg == b.neg && a.d == b.d; }
+bool operator!=(const BigInt& a, const BigInt& b) { return !(a == b); }
+bool operator<(const BigInt& a, const BigInt& b) { return BigInt::cmp(a, b) < 0; }
+bool operator>(const BigInt& a, const BigInt& b) { return BigInt::cmp(a, b) > 0; }
+bool operator<=(const BigInt& a, const BigInt& b) { return BigInt::cmp(a, b) <= 0; }
+bool operator>=(const BigInt& a, const BigInt& b) { return BigInt::cmp(a, b) >= 0; }
+
+ostream& operator<<(ostream& os, const BigInt& x) {
+    x.write(os);
+    return os;
+}
+istream& operator>>(istream& is, BigInt& x) {
+    string s;
+    if (is >> s) x.parse(s);
+    return is;
+}
+
+// ========== 原版 base-10 函数 (对照组，摘自 05 ~ 08 与 07_mul_AB) ==========
+namespace old {
+
+vector<int> from_string(const string& s) {
+    vector<int> A;
+    for (int i = (int)s.size() - 1; i >= 0; i--) A.push_back(s[i] - '0');
+    return A;
+}
+
+string to_string(const vector<int>& A) {
+    string s;
+    for (int i = (int)A.size() - 1; i >= 0; i--) s += (char)('0' + A[i]);
+    return s;
+}
+
+vector<int> add(vector<int>& A, vector<int>& B) {
+    if (A.size() < B.size()) return add(B, A);
+    vector<int> C;
+    int t = 0;
+    for (size_t i = 0; i < A.size(); i++) {
+        t += A[i];
+        if (i < B.size()) t += B[i];
+        C.push_back(t % 10);
+        t /= 10;
+    }
+    if (t) C.push_back(t);
+    return C;
+}
+
+vector<int> sub(vector<int>& A, vector<int>& B) {
+    vector<int> C;
+    int t = 0;
+    for (size_t i = 0; i < A.size(); i++) {
+        t = A[i] - t;
+        if (i < B.size()) t -= B[i];
+        C.push_back((t + 10) % 10);
+        t = t < 0;
+    }
+    while (C.size() > 1 && C.back() == 0) C.pop_back();
+    return C;
+}
+
+vector<int> mul(vector<int>& A, int b) {
+    vector<int> C;
+    int t = 0;
+    for (size_t i = 0; i < A.size() || t; i++) {
+        if (i < A.size()) t += A[i] * b;
+        C.push_back(t % 10);
+        t /= 10;
+    }
+    while (C.size() > 1 && C.back() == 0) C.pop_back();
+    return C;
+}
+
+vector<int> mul_AB(vector<int>& A, vector<int>& B) {
+    vector<int> C(A.size() + B.size() + 1, 0);
+    for (size_t i = 0; i < A.size(); i++)
+        for (size_t j = 0; j < B.size(); j++) {
+            C[i + j] += A[i] * B[j];
+            C[i + j + 1] += C[i + j] / 10;
+            C[i + j] %= 10;
+        }
+    while (C.size() > 1 && C.back() == 0) C.pop_back();
+    return C;
+}
+
+vector<int> div(vector<int>& A, int b, int& r) {
+    vector<int> C;
+    r = 0;
+    for (int i = (int)A.size() - 1; i >= 0; i--) {
+        r = r * 10 + A[i];
+        C.push_back(r / b);
+        r %= b;
+    }
+    reverse(C.begin(), C.end());
+    while (C.size() > 1 && C.back() == 0) C.pop_back();
+    return C;
+}
+
+// 大数除大数的"胶水代码"写法：按十进制逐位试商，每一位靠反复减法 (最多减 9 次)
+bool cmp(vector<int>& A, vector<int>& B) {
+    if (A.size() != B.size()) return A.size() > B.size();
+    for (int i = (int)A.size() - 1; i >= 0; i--)
+        if (A[i] != B[i]) return A[i] > B[i];
+    return true;
+}
+
+vector<int> div_big(vector<int>& A, vector<int>& B, vector<int>& R) {
+    vector<int> C;
+    R.clear();
+    for (int i = (int)A.size() - 1; i >= 0; i--) {
+        R.insert(R.begin(), A[i]); // R = R * 10 + A[i]
+        while (R.size() > 1 && R.back() == 0) R.pop_back();
+        int q = 0;
+        while (cmp(R, B)) R = sub(R, B), q++;
+        C.push_back(q);
+    }
+    reverse(C.begin(), C.end());
+    while (C.size() > 1 && C.back() == 0) C.pop_back();
+    return C;
+}
+
+} // namespace old
+
+// ========== 基准测试 ==========
+string random_digits(mt19937& rng, int len) {
+    string s(len, '0');
+    for (auto& c : s) c = (char)('0' + rng() % 10);
+    s[0] = (char)('1' + rng() % 9);
+    return s;
+}
+
+void benchmark(int max_digits) {
+    mt19937 rng(20260105);
+    const int b = 99991; // 原版 mul(A, b) 里 t += A[i] * b，b 太大会溢出 int
+    for (int len = 10000; len <= max_digits; len *= 10) {
+        string sa = random_digits(rng, len), sb = random_digits(rng, len - len / 7);
+        printf("digits = %d\n", len);
+
+        vector<int> A = old::from_string(sa), B = old::from_string(sb);
+        BigInt X(sa), Y(sb);
+        bool ok = true;
+
+        auto row = [&](const char* name, double t_old, double t_new) {
+            if (t_old < 0) printf("  %-10s old %10s      new %9.2f ms\n", name, "(skipped)", t_new);
+            else printf("  %-10s old %9.2f ms   new %9.2f ms   x%.1f\n", name, t_old, t_new, t_old / t_new);
+        };
+
+        // 十进制读写：原版逐位存取 vs 压位 SWAR 解析 / 两位查表流式输出
+        auto st = chrono::steady_clock::now();
+        vector<int> D = old::from_string(sa);
+        double t1 = bench::elapsed_ms(st);
+        BigInt W;
+        st = chrono::steady_clock::now();
+        W.parse(sa);
+        double t2 = bench::elapsed_ms(st);
+        ok = ok && W == X && D == A;
+        row("parse", t1, t2);
+
+        st = chrono::steady_clock::now();
+        string so = old::to_string(A);
+        t1 = bench::elapsed_ms(st);
+        ostringstream os;
+        st = chrono::steady_clock::now();
+        os << X;
+        t2 = bench::elapsed_ms(st);
+        ok = ok && so == sa && os.str() == sa;
+        row("print", t1, t2);
+
+        st = chrono::steady_clock::now();
+        vector<int> C = old::add(A, B);
+        t1 = bench::elapsed_ms(st);
+        st = chrono::steady_clock::now();
+        BigInt Z = X;
+        Z += Y;
+        t2 = bench::elapsed_ms(st);
+        ok = ok && old::to_string(C) == Z.to_string();
+        row("A + B", t1, t2);
+
+        st = chrono::steady_clock::now();
+        C = old::sub(A, B);
+        t1 = bench::elapsed_ms(st);
+        st = chrono::steady_clock::now();
+        Z = X;
+        Z -= Y;
+        t2 = bench::elapsed_ms(st);
+        ok = ok && old::to_string(C) == Z.to_string();
+        row("A - B", t1, t2);
+
+        st = chrono::steady_clock::now();
+        C = old::mul(A, b);
+        t1 = bench::elapsed_ms(st);
+        st = chrono::steady_clock::now();
+        Z = X * b;
+        t2 = bench::elapsed_ms(st);
+        ok = ok && old::to_string(C) == Z.to_string();
+        row("A * b", t1, t2);
+
+        int r1, r2;
+        st = chrono::steady_clock::now();
+        C = old::div(A, b, r1);
+        t1 = bench::elapsed_ms(st);
+        st = chrono::steady_clock::now();
+        Z = X;
+        r2 = Z.divmod_small(b);
+        t2 = bench::elapsed_ms(st);
+        ok = ok && old::to_string(C) == Z.to_string() && r1 == r2;
+        row("A / b", t1, t2);
+
+        // 原版 O(n^2) 卷积在 10^5 位上要跑一分钟以上，只在 10^4 位上对比
+        t1 = -1;
+        if (len <= 10000) {
+            st = chrono::steady_clock::now();
+            C = old::mul_AB(A, B);
+            t1 = bench::elapsed_ms(st);
+        }
+        st = chrono::steady_clock::now();
+        Z = X * Y;
+        t2 = bench::elapsed_ms(st);
+        if (len <= 10000) ok = ok && old::to_string(C) == Z.to_string();
+        row("A * B", t1, t2);
+
+        // 长 x 短：短的一方 450 位 (50 个 limb) 走竖式，原版只在 10^4 位上对比
+        string ss = random_digits(rng, 450);
+        vector<int> SA = old::from_string(ss);
+        BigInt S(ss);
+        t1 = -1;
+        if (len <= 10000) {
+            st = chrono::steady_clock::now();
+            C = old::mul_AB(A, SA);
+            t1 = bench::elapsed_ms(st);
+        }
+        st = chrono::steady_clock::now();
+        Z = X * S;
+        t2 = bench::elapsed_ms(st);
+        if (len <= 10000) ok = ok && old::to_string(C) == Z.to_string();
+        BigInt SR;
+        ok = ok && BigInt::divmod(Z, S, SR) == X && SR == BigInt();
+        row("A * s", t1, t2);
+
+        // 除法：(2 * len) 位 / len 位。原版反复减法只在 10^4 位上对比
+        BigInt P = X * X + Y, Q, R;
+        t1 = -1;
+        string sp = P.to_string();
+        vector<int> PA = old::from_string(sp), RA;
+        if (len <= 10000) {
+            st = chrono::steady_clock::now();
+            C = old::div_big(PA, A, RA);
+            t1 = bench::elapsed_ms(st);
+        }
+        st = chrono::steady_clock::now();
+        Q = BigInt::divmod(P, X, R);
+        t2 = bench::elapsed_ms(st);
+        ok = ok && Q == X && R == Y;
+        if (len <= 10000) ok = ok && old::to_string(C) == Q.to_string() && old::to_string(RA) == R.to_string();
+        row("A / B", t1, t2);
+
+        // 两档算法单独计时，看牛顿在哪里反超 Knuth D
+        vector<int> rk, rn;
+        st = chrono::steady_clock::now();
+        vector<int> qk = BigInt::divmod_knuth(P.d, X.d, rk);
+        double tk = bench::elapsed_ms(st);
+        st = chrono::steady_clock::now();
+        vector<int> qn = BigInt::divmod_newton(P.d, X.d, rn);
+        double tn = bench::elapsed_ms(st);
+        ok = ok && qk == qn && rk == rn;
+        printf("  %-10s knuth %7.2f ms   newton %7.2f ms\n", "  (detail)", tk, tn);
+
+        printf("  results %s\n", ok ? "identical" : "MISMATCH!");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        benchmark(argc >= 3 ? atoi(argv[2]) : 1000000);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    BigInt a, b;
+    if (!(cin >> a >> b)) return 0;
+    cout << a + b << "\n" << a - b << "\n" << a * b << "\n";
+    if (!b.is_zero()) {
+        BigInt r;
+        BigInt q = BigInt::divmod(a, b, r);
+        cout << q << "\n" << r << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,424 @@
+/*
+ * ============================================
+ *   可回收的链表内存池 (Arena + Free List) - 单链表 / 双链表模板
+ *   基于 01_single_linked_list.cpp / 02_double_linked_list.cpp
+ *   题目来源: AcWing 826. 单链表 / AcWing 827. 双链表
+ * ============================================
+ *
+ * 【原版的局限】
+ *   e[N], ne[N], idx 是固定大小的全局池，idx 只增不减：
+ *   删掉的节点永远不还回来，一个不停增删的长期进程 (比如维护几百万个在线会话)
+ *   迟早把 N 用完，哪怕同时活着的节点一直不多。而且全局数组只能有一条链表。
+ *
+ * 【内存池 = 原版的数组 + 一条"空闲链"】
+ *   节点仍然是数组下标 (32 位句柄，比 64 位指针省一半)，数组换成 vector，不够就长；
+ *   e / ne / pr 三个数组并成一个 {e, ne, pr} 结构体数组，碰一个节点只碰一条缓存行。
+ *   删掉的节点挂到空闲链上 (直接复用 ne 当空闲链的 next)，下次分配先从空闲链拿：
+ *
+ *     e:    [10] [20] [30] [40]
+ *     ne:   [ 2] [ 3] [-1] [ 0]       链表: head=1 -> 3 -> 0 -> 2
+ *     删掉 3 之后：ne[1] = 0，ne[3] = free_head，free_head = 3
+ *     再插入一个数：拿走 free_head = 3，池子不用变大
+ *
+ *   池子的大小 = 历史上同时活着的节点数的峰值，而不是总共插入过多少次。
+ *
+ * 【多条链表共用一个池】
+ *   链表本身只是 (head, tail, size) 三个数，节点全在池里。
+ *   所以把节点从一条链表挪到另一条 (splice)、合并两条有序链表 (merge)
+ *   都只是改几个 ne / pr，不分配也不释放任何内存。
+ *
+ * 【接口】
+ *   Arena<T, DOUBLY>  节点池：alloc(x) / release(h)，DOUBLY 时节点多一个 pr (前驱)
+ *   SList<T>          单链表：push_front / push_back / insert_after / erase_after / pop_front,
+ *                             splice_back (整条接到尾巴上) / merge
+ *   DList<T>          双链表：push_front / push_back / insert_before / insert_after / erase,
+ *                             move_to_front / splice (单个节点或整条) / merge
+ *   句柄在节点被删除之前一直有效；删除之后可能被新节点复用。
+ *
+ * 【复杂度】
+ *   - 插入 / 删除 / splice：O(1) (池子扩容均摊 O(1))
+ *   - merge：O(n + m)，只改链接
+ *   - 空间：同时活着的节点数的峰值 x (sizeof(T) + 4 或 8 字节)
+ *
+ * 【用法】
+ *   ./a.out                   AcWing 826：H x / D k / I k x
+ *   ./a.out double            AcWing 827：L x / R x / D k / IL k x / IR k x
+ *   ./a.out bench [会话数] [操作数]
+ *   编译: g++ -std=c++17 -O2 01_single_linked_list_arena.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+typedef uint32_t Handle;
+const Handle NIL = 0xFFFFFFFFu; // 相当于原版的 -1
+
+// ========== 节点池 ==========
+// 一个节点的值和链接放在一起 (原版 e[i] / ne[i] 分在两个数组，访问一个节点要碰两条缓存行)
+template <class T, bool DOUBLY>
+struct Node {
+    T e;
+    Handle ne, pr;
+};
+template <class T>
+struct Node<T, false> {
+    T e;
+    Handle ne;
+};
+
+template <class T, bool DOUBLY>
+struct Arena {
+    vector<Node<T, DOUBLY>> t;
+    Handle free_head = NIL;
+    size_t live = 0;
+
+    T& e(Handle h) { return t[h].e; }
+    Handle& ne(Handle h) { return t[h].ne; }
+    Handle& pr(Handle h) { return t[h].pr; }
+
+    void reserve(size_t n) { t.reserve(n); }
+
+    Handle alloc(const T& x) {
+        Handle h;
+        if (free_head != NIL) {
+            h = free_head;
+            free_head = t[h].ne; // 空闲链直接复用 ne
+        } else {
+            h = t.size();
+            t.emplace_back();
+        }
+        t[h].e = x;
+        live++;
+        return h;
+    }
+
+    void release(Handle h) {
+        t[h].ne = free_head;
+        free_head = h;
+        live--;
+    }
+
+    size_t capacity() const { return t.size(); }
+};
+
+// ========== 单链表 ==========
+template <class T>
+struct SList {
+    typedef Arena<T, false> Pool;
+    Pool* a;
+    Handle head = NIL, tail = NIL;
+    size_t n = 0;
+
+    explicit SList(Pool& pool) : a(&pool) {}
+
+    T& val(Handle h) { return a->e(h); }
+    Handle next(Handle h) const { return a->ne(h); }
+    bool empty() const { return n == 0; }
+    size_t size() const { return n; }
+
+    Handle push_front(const T& x) {
+        Handle h = a->alloc(x);
+        a->ne(h) = head;
+        head = h;
+        if (tail == NIL) tail = h;
+        n++;
+        return h;
+    }
+
+    Handle push_back(const T& x) {
+        if (tail == NIL) return push_front(x);
+        return insert_after(tail, x);
+    }
+
+    // 在 k 后面插入 x
+    Handle insert_after(Handle k, const T& x) {
+        Handle h = a->alloc(x);
+        a->ne(h) = a->ne(k);
+        a->ne(k) = h;
+        if (tail == k) tail = h;
+        n++;
+        return h;
+    }
+
+    void pop_front() {
+        Handle h = head;
+        head = a->ne(h);
+        if (head == NIL) tail = NIL;
+        a->release(h);
+        n--;
+    }
+
+    // 删掉 k 后面的节点，并把它还给池子
+    void erase_after(Handle k) {
+        Handle h = a->ne(k);
+        a->ne(k) = a->ne(h);
+        if (tail == h) tail = k;
+        a->release(h);
+        n--;
+    }
+
+    // 把 o 整条接到尾巴上，o 变空
+    void splice_back(SList& o) {
+        if (o.empty()) return;
+        if (empty()) head = o.head;
+        else a->ne(tail) = o.head;
+        tail = o.tail, n += o.n;
+        o.head = o.tail = NIL, o.n = 0;
+    }
+
+    // 两条按 less 有序的链表合并成一条 (稳定，相等时本链表的在前)，o 变空
+    template <class Less>
+    void merge(SList& o, Less less) {
+        Handle x = head, y = o.head, h = NIL, t = NIL;
+        auto append = [&](Handle z) {
+            if (t == NIL) h = z;
+            else a->ne(t) = z;
+            t = z;
+        };
+        while (x != NIL && y != NIL) {
+            if (less(a->e(y), a->e(x))) append(y), y = a->ne(y);
+            else append(x), x = a->ne(x);
+        }
+        if (x != NIL) append(x);
+        else if (y != NIL) append(y), tail = o.tail;
+        head = h, n += o.n;
+        o.head = o.tail = NIL, o.n = 0;
+    }
+
+    void clear() {
+        while (!empty()) pop_front();
+    }
+};
+
+// ========== 双链表 ==========
+template <class T>
+struct DList {
+    typedef Arena<T, true> Pool;
+    Pool* a;
+    Handle head = NIL, tail = NIL;
+    size_t n = 0;
+
+    explicit DList(Pool& pool) : a(&pool) {}
+
+    T& val(Handle h) { return a->e(h); }
+    Handle next(Handle h) const { return a->ne(h); }
+    Handle prev(Handle h) const { return a->pr(h); }
+    bool empty() const { return n == 0; }
+    size_t size() const { return n; }
+
+    // 把已经分配好的 h 挂到 pos 前面 (pos == NIL 表示挂到最后)
+    void link_before(Handle pos, Handle h) {
+        Handle p = pos == NIL ? tail : a->pr(pos);
+        a->ne(h) = pos, a->pr(h) = p;
+        if (p == NIL) head = h;
+        else a->ne(p) = h;
+        if (pos == NIL) tail = h;
+        else a->pr(pos) = h;
+        n++;
+    }
+
+    // 把 h 从链上摘下来，但不还给池子
+    void unlink(Handle h) {
+        Handle p = a->pr(h), q = a->ne(h);
+        if (p == NIL) head = q;
+        else a->ne(p) = q;
+        if (q == NIL) tail = p;
+        else a->pr(q) = p;
+        n--;
+    }
+
+    Handle insert_before(Handle pos, const T& x) {
+        Handle h = a->alloc(x);
+        link_before(pos, h);
+        return h;
+    }
+    Handle insert_after(Handle pos, const T& x) { return insert_before(a->ne(pos), x); }
+    Handle push_front(const T& x) { return insert_before(head, x); }
+    Handle push_back(const T& x) { return insert_before(NIL, x); }
+
+    void erase(Handle h) {
+        unlink(h);
+        a->release(h);
+    }
+    void pop_front() { erase(head); }
+    void pop_back() { erase(tail); }
+
+    // LRU 的"访问一次就挪到最前面"
+    void move_to_front(Handle h) {
+        if (h == head) return;
+        unlink(h);
+        link_before(head, h);
+    }
+
+    // 把 o 里的节点 h 挪到本链表 pos 前面 (o 可以就是自己)
+    void splice(Handle pos, DList& o, Handle h) {
+        if (pos == h) return;
+        o.unlink(h);
+        link_before(pos, h);
+    }
+
+    // 把 o 整条插到 pos 前面，o 变空
+    void splice(Handle pos, DList& o) {
+        if (o.empty()) return;
+        Handle p = pos == NIL ? tail : a->pr(pos);
+        a->pr(o.head) = p, a->ne(o.tail) = pos;
+        if (p == NIL) head = o.head;
+        else a->ne(p) = o.head;
+        if (pos == NIL) tail = o.tail;
+        else a->pr(pos) = o.tail;
+        n += o.n;
+        o.head = o.tail = NIL, o.n = 0;
+    }
+
+    // 两条有序链表合并 (稳定)，o 变空
+    template <class Less>
+    void merge(DList& o, Less less) {
+        Handle x = head, y = o.head, h = NIL, t = NIL;
+        auto append = [&](Handle z) {
+            if (t == NIL) h = z;
+            else a->ne(t) = z;
+            a->pr(z) = t;
+            t = z;
+        };
+        while (x != NIL && y != NIL) {
+            if (less(a->e(y), a->e(x))) append(y), y = a->ne(y);
+            else append(x), x = a->ne(x);
+        }
+        if (x != NIL) append(x);
+        else if (y != NIL) append(y), tail = o.tail;
+        head = h, n += o.n;
+        o.head = o.tail = NIL, o.n = 0;
+    }
+
+    void clear() {
+        while (!empty()) pop_front();
+    }
+};
+
+// ========== 基准测试 ==========
+// 会话 LRU：S 个会话按最近活跃排成一条链，随机地
+//   60% 某个会话活跃 (挪到最前)，20% 最久没动的会话过期后重新登录 (删尾 + 插头)，
+//   20% 某个会话断线重连 (删掉 + 插头)
+// 对照组是 std::list (每个节点一次 new / delete)
+void benchmark(int S, int M) {
+    mt19937 rng(20260117);
+    vector<unsigned> ops(M);
+    for (auto& x : ops) x = rng();
+    printf("%d sessions, %d ops\n", S, M);
+
+    auto st = chrono::steady_clock::now();
+    LL ref = 0;
+    {
+        list<int> L;
+        vector<list<int>::iterator> where(S);
+        for (int i = 0; i < S; i++) where[i] = L.insert(L.begin(), i);
+        for (unsigned r : ops) {
+            int kind = r % 10, id = r / 10 % S;
+            if (kind < 6) L.splice(L.begin(), L, where[id]);
+            else {
+                if (kind < 8) id = L.back();
+                L.erase(where[id]);
+                where[id] = L.insert(L.begin(), id);
+            }
+        }
+        LL pos = 0;
+        for (int id : L) ref += ++pos * id;
+    }
+    double t_list = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    LL got = 0;
+    size_t cap;
+    {
+        DList<int>::Pool pool;
+        pool.reserve(S);
+        DList<int> L(pool);
+        vector<Handle> where(S);
+        for (int i = 0; i < S; i++) where[i] = L.push_front(i);
+        for (unsigned r : ops) {
+            int kind = r % 10, id = r / 10 % S;
+            if (kind < 6) L.move_to_front(where[id]);
+            else {
+                if (kind < 8) id = L.val(L.tail);
+                L.erase(where[id]);
+                where[id] = L.push_front(id);
+            }
+        }
+        LL pos = 0;
+        for (Handle h = L.head; h != NIL; h = L.next(h)) got += ++pos * L.val(h);
+        cap = pool.capacity();
+    }
+    double t_arena = bench::elapsed_ms(st);
+
+    LL churn = 0;
+    for (unsigned r : ops) churn += r % 10 >= 6;
+    bench::row("std::list + iterators", t_list, true, 30);
+    bench::row("arena DList + 32-bit handles", t_arena, got == ref, 30);
+    printf("  arena nodes: %zu (original idx-only pool would need %lld)\n", cap, S + churn);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int S = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int M = argc >= 4 ? atoi(argv[3]) : 20000000;
+        benchmark(S, M);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    int m;
+    if (!(cin >> m)) return 0;
+    vector<Handle> ins; // 第 k 个插入的数 -> 句柄 (节点会被回收，不能再用 k - 1 当下标)
+
+    if (argc >= 2 && strcmp(argv[1], "double") == 0) {
+        // AcWing 827: 输入 10 / R 7 / D 1 / L 3 / IL 2 10 / D 3 / IL 2 7 / L 8 / R 9 / IL 4 7 / IR 2 2
+        //             输出 8 7 7 3 2 9
+        DList<int>::Pool pool;
+        DList<int> L(pool);
+        while (m--) {
+            string op;
+            int k, x;
+            cin >> op;
+            if (op == "L") cin >> x, ins.push_back(L.push_front(x));
+            else if (op == "R") cin >> x, ins.push_back(L.push_back(x));
+            else if (op == "D") cin >> k, L.erase(ins[k - 1]);
+            else if (op == "IL") cin >> k >> x, ins.push_back(L.insert_before(ins[k - 1], x));
+            else cin >> k >> x, ins.push_back(L.insert_after(ins[k - 1], x));
+        }
+        for (Handle h = L.head; h != NIL; h = L.next(h)) cout << L.val(h) << " ";
+        cout << endl;
+        return 0;
+    }
+
+    // AcWing 826: 输入 10 / H 9 / I 1 1 / D 1 / D 0 / H 6 / I 3 6 / I 4 5 / I 4 5 / I 3 4 / D 6
+    //             输出 6 4 6 5
+    SList<int>::Pool pool;
+    SList<int> L(pool);
+    while (m--) {
+        char op;
+        int k, x;
+        cin >> op;
+        if (op == 'H') cin >> x, ins.push_back(L.push_front(x));
+        else if (op == 'D') {
+            cin >> k;
+            if (k == 0) L.pop_front();
+            else L.erase_after(ins[k - 1]);
+        } else cin >> k >> x, ins.push_back(L.insert_after(ins[k - 1], x));
+    }
+    for (Handle h = L.head; h != NIL; h = L.next(h)) cout << L.val(h) << " ";
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,355 @@
+/*
+ * ============================================
+ *   无锁环形队列 - SPSC (wait-free) / MPMC (Vyukov)
+ *   基于 04_queue.cpp
+ *   题目来源: AcWing 829. 模拟队列
+ * ============================================
+ *
+ * 【原版的局限】
+ *   q[N] + hh / tt 只能单线程用，而且 hh 只增不减，数组用过一遍就废了。
+ *   流水线 (解析线程 -> 计算线程 -> 输出线程) 需要有界、线程安全、不加锁的队列。
+ *
+ * 【环形：hh / tt 只增不减，下标 & mask】
+ *   容量取 2 的幂 cap，hh / tt 是不回绕的 64 位计数 (和原版一样只增)，
+ *   真正的位置是 hh & (cap - 1)。tt - hh 就是队列长度，满 = (tt - hh == cap)，空 = (hh == tt)。
+ *
+ * 【SPSC：一个生产者 + 一个消费者，wait-free】
+ *   tt 只有生产者写，hh 只有消费者写，谁都不会重试：
+ *     生产者: 写 q[tt & mask]，再 store(tt + 1, release)   <- 先写数据后发布
+ *     消费者: load(tt, acquire) 看到新的 tt，就一定能看到数据
+ *   每一方再缓存一份对方的下标 (hh_cache / tt_cache)，只有"看起来满了 / 空了"才去读对方的缓存行，
+ *   平时两个线程各碰各的缓存行。
+ *
+ *     [ tt | hh_cache | 填充到 64 字节 ]   <- 生产者的缓存行
+ *     [ hh | tt_cache | 填充到 64 字节 ]   <- 消费者的缓存行
+ *
+ *   不填充的话 hh 和 tt 落在同一条缓存行，两个核每次写都把对方的缓存行作废 (伪共享)。
+ *
+ * 【MPMC：Vyukov 有界队列】
+ *   多个生产者抢同一个 tt，得 CAS。每个格子带一个序号 seq，说明它现在归谁：
+ *     seq == pos        格子空着，等"第 pos 个入队的"来写
+ *     seq == pos + 1    格子里有数据，等"第 pos 个出队的"来读
+ *   入队: pos = tt；格子的 seq == pos 就 CAS(tt, pos, pos + 1) 抢下来，写数据，seq = pos + 1
+ *         seq < pos 说明这一圈的消费者还没读走 (满了)，seq > pos 说明被别人抢了，重读 tt
+ *   出队: 对称，读完把 seq 设成 pos + cap (下一圈的入队者可以用了)
+ *   写数据和改 seq 不在一个原子操作里也没关系：格子在 seq 改好之前谁都不会碰。
+ *
+ * 【批量】
+ *   SPSC：一次看好有多少空位 / 多少数据，拷一段，只发布一次下标。
+ *   MPMC：从 pos 开始数连续几个格子可用 (最多 k 个)，一次 CAS 把这一段全抢下来，
+ *         k 个元素只争用一次 tt / hh。
+ *
+ * 【复杂度】
+ *   - push / pop：O(1)；SPSC 从不重试，MPMC 冲突时 CAS 重试
+ *   - 空间：cap 个元素 (MPMC 每格多一个 8 字节序号) + 两条独占的缓存行
+ *
+ * 【用法】
+ *   ./a.out                         AcWing 829：push x / pop / empty / query
+ *   ./a.out bench [元素数] [最大线程数]
+ *   编译: g++ -std=c++17 -O2 -pthread 04_queue_lockfree.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+const int CACHELINE = 64;
+
+// ========== SPSC ==========
+template <class T>
+struct SpscRing {
+    vector<T> q;
+    size_t mask;
+
+    alignas(CACHELINE) atomic<size_t> tt{0}; // 生产者的缓存行
+    size_t hh_cache = 0;
+    alignas(CACHELINE) atomic<size_t> hh{0}; // 消费者的缓存行
+    size_t tt_cache = 0; // 结构体按 64 对齐，末尾自动补齐到整条缓存行
+
+    explicit SpscRing(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        q.resize(cap);
+        mask = cap - 1;
+    }
+
+    // ---- 生产者 ----
+    bool try_push(const T& x) {
+        size_t t = tt.load(memory_order_relaxed);
+        if (t - hh_cache > mask) { // 看起来满了，才去读消费者的 hh
+            hh_cache = hh.load(memory_order_acquire);
+            if (t - hh_cache > mask) return false;
+        }
+        q[t & mask] = x;
+        tt.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // 尽量放 a[0, n)，返回放进去的个数
+    size_t push_batch(const T* a, size_t n) {
+        size_t t = tt.load(memory_order_relaxed);
+        size_t room = mask + 1 - (t - hh_cache);
+        if (room < n) {
+            hh_cache = hh.load(memory_order_acquire);
+            room = mask + 1 - (t - hh_cache);
+        }
+        n = min(n, room);
+        for (size_t i = 0; i < n; i++) q[(t + i) & mask] = a[i];
+        tt.store(t + n, memory_order_release);
+        return n;
+    }
+
+    // ---- 消费者 ----
+    bool try_pop(T& x) {
+        size_t h = hh.load(memory_order_relaxed);
+        if (h == tt_cache) {
+            tt_cache = tt.load(memory_order_acquire);
+            if (h == tt_cache) return false;
+        }
+        x = q[h & mask];
+        hh.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    // 最多取 n 个到 out，返回取到的个数
+    size_t pop_batch(T* out, size_t n) {
+        size_t h = hh.load(memory_order_relaxed);
+        if (tt_cache - h < n) tt_cache = tt.load(memory_order_acquire);
+        n = min(n, tt_cache - h);
+        for (size_t i = 0; i < n; i++) out[i] = q[(h + i) & mask];
+        hh.store(h + n, memory_order_release);
+        return n;
+    }
+
+    // 队头 (消费者调用，调用前先确认非空)
+    const T& front() const { return q[hh.load(memory_order_relaxed) & mask]; }
+    bool empty() const { return hh.load(memory_order_acquire) == tt.load(memory_order_acquire); }
+};
+
+// ========== MPMC (Vyukov) ==========
+template <class T>
+struct MpmcRing {
+    struct Cell {
+        atomic<size_t> seq;
+        T data;
+    };
+    vector<Cell> q;
+    size_t mask;
+
+    alignas(CACHELINE) atomic<size_t> tt{0}; // 下一个入队位置
+    alignas(CACHELINE) atomic<size_t> hh{0}; // 下一个出队位置
+
+    explicit MpmcRing(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        q = vector<Cell>(cap);
+        mask = cap - 1;
+        for (size_t i = 0; i < cap; i++) q[i].seq.store(i, memory_order_relaxed);
+    }
+
+    // 从 pos 开始，数出最多 n 个连续的、seq == pos + i + ready 的格子 (ready = 0 空位 / 1 有数据)
+    size_t run_length(size_t pos, size_t n, size_t ready) const {
+        size_t k = 0;
+        while (k < n && q[(pos + k) & mask].seq.load(memory_order_acquire) == pos + k + ready) k++;
+        return k;
+    }
+
+    // 抢下 [pos, pos + k)；抢不到返回 0 (满 / 空)
+    size_t claim(atomic<size_t>& idx, size_t n, size_t ready, size_t& pos) {
+        pos = idx.load(memory_order_relaxed);
+        for (;;) {
+            size_t seq = q[pos & mask].seq.load(memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos + ready);
+            if (dif == 0) {
+                size_t k = run_length(pos, n, ready);
+                if (k == 0) { // 刚数的时候被别人抢了
+                    pos = idx.load(memory_order_relaxed);
+                    continue;
+                }
+                if (idx.compare_exchange_weak(pos, pos + k, memory_order_relaxed)) return k;
+            } else if (dif < 0) {
+                return 0; // 这一圈还没轮到：入队时是满了，出队时是空了
+            } else {
+                pos = idx.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t push_batch(const T* a, size_t n) {
+        size_t pos, k = claim(tt, n, 0, pos);
+        for (size_t i = 0; i < k; i++) {
+            Cell& c = q[(pos + i) & mask];
+            c.data = a[i];
+            c.seq.store(pos + i + 1, memory_order_release);
+        }
+        return k;
+    }
+
+    size_t pop_batch(T* out, size_t n) {
+        size_t pos, k = claim(hh, n, 1, pos);
+        for (size_t i = 0; i < k; i++) {
+            Cell& c = q[(pos + i) & mask];
+            out[i] = c.data;
+            c.seq.store(pos + i + mask + 1, memory_order_release);
+        }
+        return k;
+    }
+
+    bool try_push(const T& x) { return push_batch(&x, 1) == 1; }
+    bool try_pop(T& x) { return pop_batch(&x, 1) == 1; }
+};
+
+// ========== 基准测试 ==========
+// 对照组：std::queue + mutex
+template <class T>
+struct LockedQueue {
+    queue<T> q;
+    mutex mu;
+    size_t cap;
+    explicit LockedQueue(size_t c) : cap(c) {}
+    bool try_push(const T& x) {
+        lock_guard<mutex> g(mu);
+        if (q.size() >= cap) return false;
+        q.push(x);
+        return true;
+    }
+    bool try_pop(T& x) {
+        lock_guard<mutex> g(mu);
+        if (q.empty()) return false;
+        x = q.front();
+        q.pop();
+        return true;
+    }
+    size_t push_batch(const T* a, size_t n) {
+        lock_guard<mutex> g(mu);
+        n = min(n, cap - q.size());
+        for (size_t i = 0; i < n; i++) q.push(a[i]);
+        return n;
+    }
+    size_t pop_batch(T* out, size_t n) {
+        lock_guard<mutex> g(mu);
+        n = min(n, q.size());
+        for (size_t i = 0; i < n; i++) out[i] = q.front(), q.pop();
+        return n;
+    }
+};
+
+const size_t BENCH_CAP = 1 << 14;
+
+// P 个生产者各推 per 个数 (值 1 .. per)，C 个消费者一起取完；batch = 1 时用 try_push / try_pop
+// 返回耗时，sum 收到所有取出值之和 (应等于 P * per * (per + 1) / 2)
+template <class Q>
+double run_pipeline(int P, int C, LL per, size_t batch, LL& sum) {
+    Q ring(BENCH_CAP);
+    atomic<LL> got{0}, total{0};
+    LL need = P * per;
+    auto producer = [&]() {
+        vector<LL> buf(batch);
+        for (LL v = 1; v <= per;) {
+            size_t k = 0;
+            if (batch == 1) k = ring.try_push(v);
+            else {
+                size_t n = min<LL>(batch, per - v + 1);
+                for (size_t i = 0; i < n; i++) buf[i] = v + i;
+                k = ring.push_batch(buf.data(), n);
+            }
+            if (k == 0) this_thread::yield();
+            v += k;
+        }
+    };
+    auto consumer = [&]() {
+        vector<LL> buf(batch);
+        LL s = 0;
+        while (got.load(memory_order_relaxed) < need) {
+            size_t k = batch == 1 ? ring.try_pop(buf[0]) : ring.pop_batch(buf.data(), batch);
+            if (k == 0) {
+                this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < k; i++) s += buf[i];
+            got.fetch_add(k, memory_order_relaxed);
+        }
+        total.fetch_add(s);
+    };
+
+    auto st = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int i = 0; i < P; i++) pool.emplace_back(producer);
+    for (int i = 0; i < C; i++) pool.emplace_back(consumer);
+    for (auto& th : pool) th.join();
+    double ms = bench::elapsed_ms(st);
+    sum = total.load();
+    return ms;
+}
+
+void benchmark(LL n, int hw) {
+    printf("%lld items total, ring capacity %zu, hardware threads %d\n", n, BENCH_CAP, hw);
+    auto row = [&](const char* name, int P, int C, size_t batch, double ms, LL sum, LL per) {
+        char label[64];
+        snprintf(label, sizeof label, "%s %dP/%dC batch %zu", name, P, C, batch);
+        bool ok = sum == P * (per * (per + 1) / 2);
+        printf("  %-36s %9.1f ms  %7.2f Mitems/s%s\n", label, ms, P * per / ms / 1e3, bench::check(ok));
+    };
+
+    for (size_t batch : {(size_t)1, (size_t)64}) {
+        LL sum;
+        double ms = run_pipeline<LockedQueue<LL>>(1, 1, n, batch, sum);
+        row("mutex queue", 1, 1, batch, ms, sum, n);
+        ms = run_pipeline<SpscRing<LL>>(1, 1, n, batch, sum);
+        row("SPSC ring", 1, 1, batch, ms, sum, n);
+    }
+
+    vector<int> counts = {1};
+    for (int t = 2; t <= max(2, hw / 2); t *= 2) counts.push_back(t);
+    for (int t : counts) {
+        LL per = n / t;
+        for (size_t batch : {(size_t)1, (size_t)64}) {
+            LL sum;
+            double ms = run_pipeline<LockedQueue<LL>>(t, t, per, batch, sum);
+            row("mutex queue", t, t, batch, ms, sum, per);
+            ms = run_pipeline<MpmcRing<LL>>(t, t, per, batch, sum);
+            row("MPMC ring", t, t, batch, ms, sum, per);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        LL n = argc >= 3 ? atoll(argv[2]) : 20000000;
+        int hw = argc >= 4 ? atoi(argv[3]) : (int)max(2u, thread::hardware_concurrency());
+        benchmark(n, hw);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 829: 输入 10 / push 6 / empty / query / pop / empty / push 3 / push 4 / pop / query / push 6
+    //             输出 NO / 6 / YES / 4
+    int m;
+    if (!(cin >> m)) return 0;
+    SpscRing<int> q(m + 1); // 单线程里生产者、消费者是同一个人
+    while (m--) {
+        string op;
+        int x;
+        cin >> op;
+        if (op == "push") cin >> x, q.try_push(x);
+        else if (op == "pop") q.try_pop(x);
+        else if (op == "empty") cout << (q.empty() ? "YES" : "NO") << "\n";
+        else cout << q.front() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * ============================================
+ *   并行 ANSV (All Nearest Smaller Values) - 分块单调栈
+ *   基于 05_monotonic_stack.cpp
+ *   题目来源: AcWing 830. 单调栈 / AcWing 131. 直方图中最大的矩形
+ * ============================================
+ *
+ * 【问题】
+ *   对每个 i 求左边最近的 a[j] < a[i] 的下标 L[i] (没有为 -1)，
+ *   以及右边最近的 a[j] < a[i] 的下标 R[i] (没有为 n)。
+ *   有了 L / R，直方图最大矩形 = max a[i] * (R[i] - L[i] - 1)。
+ *
+ * 【原版为什么不能直接并行】
+ *   单调栈从左往右一个个压，第 i 个的答案依赖前面所有元素留在栈里的状态。
+ *
+ * 【分块：局部栈 + 合并】
+ *   把数组切成 P 块，每块一个线程：
+ *   1. 阶段一 (各块独立)：块内照原版跑单调栈。
+ *      栈空时答案在块外，记为"未决"。未决的元素是块内的前缀最小值，值从左到右不增。
+ *      块跑完后栈里剩下的是块的后缀最小值 (栈底到栈顶下标递增、值严格递增)，
+ *      栈底就是块的最小值 cmin[c]。
+ *
+ *        块 0          块 1          块 2
+ *      [5 2 7 4]     [3 8 1 6]     [9 2 5 0]
+ *       栈: 2 4       栈: 1 6       栈: 0          <- 后缀最小值
+ *       cmin = 2      cmin = 1      cmin = 0
+ *       未决: 5 2     未决: 3 1     未决: 9 2 0
+ *
+ *   2. 阶段二 (各块仍然独立)：块 c 的未决元素 x 往左找：
+ *      - 从 d = c-1 开始，cmin[d] >= x 的整块一定没有答案，直接跳过；
+ *      - 第一个 cmin[d] < x 的块里一定有答案，而且就在它的后缀最小值栈里：
+ *        离块尾最近的 < x 的元素 = 栈里最后一个 < x 的，栈有序，二分即可。
+ *      未决元素的值不增，所以 d 只会往左走，一块的合并总共 O(P + 未决数 * log)。
+ *      未决元素不单独存，阶段一先在答案数组里记 UNRESOLVED，阶段二再扫一遍本块。
+ *      阶段二只读阶段一的结果，不依赖别的块的阶段二，所以也能并行。
+ *
+ *   R[] 是镜像问题：把数组倒过来看，同一套代码，下标映射 i -> n-1-i。
+ *
+ * 【复杂度】
+ *   - 时间：O(n / P + P^2 + 未决数 * log n)，未决数 = 各块前缀最小值个数之和 (随机数据约 P ln(n/P))
+ *   - 空间：L, R 两个数组 + 一个长度 n 的暂存区 (各块的栈各占自己那一段，和原版的 stk[N] 一样大)
+ *
+ * 【用法】
+ *   ./a.out                    AcWing 830：读入 n 和数列，输出左边第一个比它小的数 (没有输出 -1)
+ *   ./a.out hist               AcWing 131：多组 n h1..hn (0 结束)，输出最大矩形面积
+ *   ./a.out bench [n] [最大线程数]
+ *   编译: g++ -std=c++17 -O2 -pthread 05_monotonic_stack_parallel.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+const int UNRESOLVED = -2;
+
+// ========== 原版单调栈 (对照组)：同时求 L 和 R ==========
+void ansv_sequential(const int* a, int n, int* L, int* R) {
+    vector<int> stk(n);
+    int tt = 0;
+    for (int i = 0; i < n; i++) {
+        while (tt > 0 && a[stk[tt - 1]] >= a[i]) tt--;
+        L[i] = tt ? stk[tt - 1] : -1;
+        stk[tt++] = i;
+    }
+    tt = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        while (tt > 0 && a[stk[tt - 1]] >= a[i]) tt--;
+        R[i] = tt ? stk[tt - 1] : n;
+        stk[tt++] = i;
+    }
+}
+
+// ========== 并行版 ==========
+// 在"逻辑下标"上求左边最近更小值：MIRROR 时逻辑下标 i 对应物理下标 n-1-i
+template <bool MIRROR>
+struct AnsvPass {
+    const int* a;
+    int n;
+    int* out;  // 物理下标上的答案
+    int parts; // 块数
+    int* buf;  // 长度 n 的暂存区：第 c 块的栈就放在 buf[begin_of(c) ..) 里 (逻辑下标)
+    vector<int> top, cmin; // 每块剩下的栈高 / 块内最小值
+
+    int get(int i) const { return a[MIRROR ? n - 1 - i : i]; }
+    int& at(int i) { return out[MIRROR ? n - 1 - i : i]; }
+    void set(int i, int j) { at(i) = MIRROR ? (j < 0 ? n : n - 1 - j) : j; } // j = -1 表示没有
+    int begin_of(int c) const { return (LL)n * c / parts; }
+
+    // 阶段一：块内单调栈，栈空的记为未决
+    void local(int c) {
+        int* s = buf + begin_of(c);
+        int tt = 0;
+        for (int i = begin_of(c); i < begin_of(c + 1); i++) {
+            int x = get(i);
+            while (tt > 0 && get(s[tt - 1]) >= x) tt--;
+            if (tt) set(i, s[tt - 1]);
+            else at(i) = UNRESOLVED;
+            s[tt++] = i;
+        }
+        top[c] = tt;
+        cmin[c] = tt ? get(s[0]) : INT32_MAX;
+    }
+
+    // 阶段二：未决元素向左边的块要答案
+    void resolve(int c) {
+        int d = c - 1;
+        for (int i = begin_of(c); i < begin_of(c + 1); i++) {
+            if (at(i) != UNRESOLVED) continue;
+            int x = get(i);
+            while (d >= 0 && cmin[d] >= x) d--;
+            if (d < 0) {
+                set(i, -1);
+                continue;
+            }
+            int* s = buf + begin_of(d);
+            int k = partition_point(s, s + top[d], [&](int j) { return get(j) < x; }) - s;
+            set(i, s[k - 1]);
+        }
+    }
+};
+
+template <bool MIRROR>
+void ansv_pass(const int* a, int n, int* out, int* buf, int threads) {
+    AnsvPass<MIRROR> P{a, n, out, threads, buf, vector<int>(threads, 0), vector<int>(threads, INT32_MAX)};
+
+    auto run = [&](auto&& job) {
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(job, t);
+        job(0);
+        for (auto& th : pool) th.join();
+    };
+    run([&](int c) { P.local(c); });
+    run([&](int c) { P.resolve(c); });
+}
+
+// ⚡ 对外接口：L[i] 左边最近更小 (无则 -1)，R[i] 右边最近更小 (无则 n)
+void ansv_parallel(const int* a, int n, int* L, int* R, int threads) {
+    threads = max(1, min(threads, max(n, 1)));
+    vector<int> buf(n);
+    ansv_pass<false>(a, n, L, buf.data(), threads);
+    ansv_pass<true>(a, n, R, buf.data(), threads);
+}
+
+// AcWing 131：直方图最大矩形
+LL largest_rectangle(const vector<int>& h, int threads) {
+    int n = h.size();
+    vector<int> L(n), R(n);
+    ansv_parallel(h.data(), n, L.data(), R.data(), threads);
+    LL best = 0;
+    for (int i = 0; i < n; i++) best = max(best, (LL)h[i] * (R[i] - L[i] - 1));
+    return best;
+}
+
+// ========== 基准测试 ==========
+void benchmark(int n, int hw) {
+    mt19937 rng(20260114);
+    vector<int> a(n), L0(n), R0(n), L(n), R(n);
+
+    vector<int> thread_counts = {1};
+    for (int t = 2; t <= hw; t *= 2) thread_counts.push_back(t);
+    if (thread_counts.back() != hw) thread_counts.push_back(hw);
+
+    auto run_case = [&](const char* name) {
+        printf("[%s] n = %d\n", name, n);
+        auto st = chrono::steady_clock::now();
+        ansv_sequential(a.data(), n, L0.data(), R0.data());
+        printf("  %-26s %10.1f ms\n", "sequential stack", bench::elapsed_ms(st));
+        for (int t : thread_counts) {
+            st = chrono::steady_clock::now();
+            ansv_parallel(a.data(), n, L.data(), R.data(), t);
+            double ms = bench::elapsed_ms(st);
+            char label[40];
+            snprintf(label, sizeof label, "ansv_parallel x%d", t);
+            printf("  %-26s %10.1f ms%s\n", label, ms, bench::check(L == L0 && R == R0));
+        }
+    };
+
+    for (auto& x : a) x = (int)(rng() % 1000000000);
+    run_case("random");
+    for (int i = 0; i < n; i++) a[i] = i;
+    run_case("increasing");
+    for (int i = 0; i < n; i++) a[i] = (int)(rng() % 4);
+    run_case("few distinct");
+}
+
+int main(int argc, char** argv) {
+    int hw = (int)max(1u, thread::hardware_concurrency());
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 50000000;
+        benchmark(n, argc >= 4 ? atoi(argv[3]) : hw);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    if (argc >= 2 && strcmp(argv[1], "hist") == 0) {
+        // AcWing 131: 输入 7 2 1 4 5 1 3 3 / 4 1000 1000 1000 1000 / 0，输出 8 / 4000
+        int n;
+        while (cin >> n && n) {
+            vector<int> h(n);
+            for (auto& x : h) cin >> x;
+            cout << largest_rectangle(h, hw) << "\n";
+        }
+        return 0;
+    }
+
+    // AcWing 830: 输入 5 / 3 4 2 7 5，输出 -1 3 -1 2 2
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<int> a(n), L(n), R(n);
+    for (auto& x : a) cin >> x;
+    ansv_parallel(a.data(), n, L.data(), R.data(), hw);
+    for (int i = 0; i < n; i++) cout << (L[i] < 0 ? -1 : a[L[i]]) << " ";
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * ============================================
+ *   流式多窗口滑动最值 (Monotonic Queue on Ring Buffer)
+ *   基于 06_monotonic_queue.cpp
+ *   题目来源: AcWing 154. 滑动窗口
+ * ============================================
+ *
+ * 【原版的局限】
+ *   - 整个数组先读进 a[N]，q[N] 也按 N 开：数据是无穷的流就没法用；
+ *   - 最小值、最大值各扫一遍，只支持一个窗口大小 k；
+ *   - 监控要同时看 1s / 10s / 60s 三个窗口，就得 3 个窗口 x 2 遍 = 6 遍。
+ *
+ * 【核心思路】
+ *   1. 环形缓冲：单调队列里存 (时间戳, 值)，不再回头查 a[]。
+ *      队列里的元素都在最大窗口 W 之内，最多 W + 1 个，
+ *      所以开 2 的幂 >= W + 1 的环，下标 & mask 取模，hh / tt 用不回绕的绝对计数。
+ *   2. 一个队列服务所有窗口：
+ *      最大窗口的单调递增队列里，时间戳从队头到队尾递增、值也递增。
+ *      小窗口 w 的最小值 = 队列里第一个时间戳 > t - w 的元素 (之前的都已经滑出 w)。
+ *      每个窗口只记一个自己的"队头指针" head[j]，它只会往后走：
+ *
+ *        队列 (时间戳):  3   7   12   15   16        t = 16
+ *                        ^        ^         ^
+ *                     W=60     w=10       w=1        各窗口的 head
+ *
+ *      新元素从队尾挤掉比它差的元素时，指向被挤掉位置的 head 直接落到新元素上
+ *      (被挤掉的都不比新元素好，新元素又一定在每个窗口里)。
+ *   3. 最小值、最大值两个队列在同一次 push 里一起维护，一遍出结果。
+ *
+ * 【两种接口】
+ *   - MultiWindowMinMax：固定的若干窗口长度，push(x) 之后查 min(j) / max(j)；
+ *   - MinMaxQueue：      普通队列 push(x) / pop()，随时查当前内容的最值 (窗口长度可变)。
+ *   窗口长度 < 1、MinMaxQueue 装满了还 push，都直接抛异常 (环是按容量开的，越界就会覆盖活的格子)。
+ *
+ * 【复杂度】
+ *   - push：均摊 O(窗口个数)，每个元素进出每个单调队列各一次
+ *   - 查询：O(1)
+ *   - 空间：2 个容量 ~W 的环 + 每个窗口 2 个指针，和流的长度无关
+ *
+ * 【用法】
+ *   ./a.out                       AcWing 154：读入 n k 和数组，输出最小值行、最大值行
+ *   ./a.out bench [n] [w1 w2 ...]
+ *   编译: g++ -std=c++17 -O2 06_monotonic_queue_streaming.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// 环形单调队列：位置 [hh, tt) 是绝对计数，实际下标 & mask
+// Better(a, b) 为真表示 a 比 b 更优 (最小值队列用 less，最大值队列用 greater)
+template <class T, class Better>
+struct MonoRing {
+    vector<LL> ti; // 时间戳
+    vector<T> val;
+    LL hh = 0, tt = 0;
+    LL mask = 0;
+    Better better;
+
+    void init(LL cap) {
+        LL sz = 1;
+        while (sz < cap) sz <<= 1;
+        ti.assign(sz, 0);
+        val.assign(sz, T());
+        mask = sz - 1;
+        hh = tt = 0;
+    }
+
+    LL time_at(LL p) const { return ti[p & mask]; }
+    const T& val_at(LL p) const { return val[p & mask]; }
+
+    // 队尾挤掉不比 x 好的，再把 (t, x) 放进去
+    void push(LL t, const T& x) {
+        while (tt > hh && !better(val_at(tt - 1), x)) tt--;
+        ti[tt & mask] = t, val[tt & mask] = x;
+        tt++;
+    }
+
+    // 把时间戳 <= limit 的从队头弹掉
+    void expire(LL limit) {
+        while (hh < tt && time_at(hh) <= limit) hh++;
+    }
+};
+
+// ========== 多窗口滑动最值 ==========
+template <class T>
+struct MultiWindowMinMax {
+    vector<LL> w; // 各窗口长度
+    LL W = 1;     // 最大窗口
+    LL t = 0;     // 已经 push 了多少个
+    MonoRing<T, less<T>> mn;
+    MonoRing<T, greater<T>> mx;
+    vector<LL> hmn, hmx; // 每个窗口在两个队列里的队头位置
+
+    // 窗口长度必须 >= 1：长度 0 的窗口连刚 push 的元素都装不下，advance 会越过队尾
+    explicit MultiWindowMinMax(const vector<LL>& windows) : w(windows) {
+        for (LL x : w) {
+            if (x < 1) throw invalid_argument("MultiWindowMinMax: window length must be >= 1");
+            W = std::max(W, x);
+        }
+        mn.init(W + 1), mx.init(W + 1);
+        hmn.assign(w.size(), 0), hmx.assign(w.size(), 0);
+    }
+
+    template <class Ring>
+    void advance(Ring& q, vector<LL>& head) {
+        q.expire(t - W);
+        for (size_t j = 0; j < w.size(); j++) {
+            LL& h = head[j];
+            if (h < q.hh) h = q.hh;
+            if (h >= q.tt) h = q.tt - 1;          // 指向的元素被挤掉了，落到新元素上
+            while (q.time_at(h) <= t - w[j]) h++; // 新元素本身一定在窗口里，不会越界
+        }
+    }
+
+    void push(const T& x) {
+        mn.push(t, x), mx.push(t, x);
+        advance(mn, hmn), advance(mx, hmx);
+        t++;
+    }
+
+    // 第 j 个窗口 (最近 min(t, w[j]) 个数) 的最小 / 最大值，要求 t >= 1
+    const T& min(int j) const { return mn.val_at(hmn[j]); }
+    const T& max(int j) const { return mx.val_at(hmx[j]); }
+    bool full(int j) const { return t >= w[j]; } // 窗口是否已经装满
+};
+
+// ========== 可 push / pop 的最值队列 ==========
+template <class T>
+struct MinMaxQueue {
+    LL front = 0, back = 0; // 队列里是时间戳 [front, back) 的元素
+    LL cap;
+    MonoRing<T, less<T>> mn;
+    MonoRing<T, greater<T>> mx;
+
+    explicit MinMaxQueue(LL capacity) : cap(capacity) { mn.init(capacity + 1), mx.init(capacity + 1); }
+
+    LL size() const { return back - front; }
+    bool empty() const { return front == back; }
+    bool full() const { return size() >= cap; }
+
+    // 满了再 push 会覆盖环里还活着的格子，所以直接拒绝
+    void push(const T& x) {
+        if (full()) throw length_error("MinMaxQueue: push beyond capacity");
+        mn.push(back, x), mx.push(back, x);
+        back++;
+    }
+    void pop() { // 弹出最早的元素
+        front++;
+        mn.expire(front - 1), mx.expire(front - 1);
+    }
+    const T& min() const { return mn.val_at(mn.hh); }
+    const T& max() const { return mx.val_at(mx.hh); }
+};
+
+// ========== 基准测试 ==========
+// 原版做法 (对照组)：每个窗口、最小 / 最大各扫一遍，返回所有满窗口最值之和
+LL original_pass(const vector<int>& a, int k, bool want_min, vector<int>& q) {
+    int n = a.size(), hh = 0, tt = -1;
+    LL sum = 0;
+    for (int i = 0; i < n; i++) {
+        if (hh <= tt && q[hh] < i - k + 1) hh++;
+        if (want_min) while (hh <= tt && a[q[tt]] >= a[i]) tt--;
+        else while (hh <= tt && a[q[tt]] <= a[i]) tt--;
+        q[++tt] = i;
+        if (i >= k - 1) sum += a[q[hh]];
+    }
+    return sum;
+}
+
+void benchmark(int n, const vector<LL>& windows) {
+    mt19937 rng(20260113);
+    vector<int> a(n);
+    for (auto& x : a) x = (int)(rng() % 1000000);
+    printf("stream of %d ints, windows:", n);
+    for (LL w : windows) printf(" %lld", w);
+    printf("\n");
+
+    int m = windows.size();
+    vector<LL> ref(2 * m), got(2 * m, 0);
+    vector<int> q(n);
+    auto st = chrono::steady_clock::now();
+    for (int j = 0; j < m; j++) {
+        ref[2 * j] = original_pass(a, windows[j], true, q);
+        ref[2 * j + 1] = original_pass(a, windows[j], false, q);
+    }
+    double t_orig = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    MultiWindowMinMax<int> mw(windows);
+    for (int i = 0; i < n; i++) {
+        mw.push(a[i]);
+        for (int j = 0; j < m; j++)
+            if (mw.full(j)) got[2 * j] += mw.min(j), got[2 * j + 1] += mw.max(j);
+    }
+    double t_stream = bench::elapsed_ms(st);
+
+    printf("  %-36s %9.1f ms  (%d passes, array of n)\n", "original, per window, min/max", t_orig, 2 * m);
+    printf("  %-36s %9.1f ms  (1 pass, ring of %lld)%s\n", "streaming multi-window", t_stream, mw.mn.mask + 1,
+           bench::check(got == ref));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 10000000;
+        vector<LL> windows;
+        for (int i = 3; i < argc; i++) windows.push_back(atoll(argv[i]));
+        if (windows.empty()) windows = {1000, 10000, 60000};
+        benchmark(n, windows);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 154: 输入 8 3 / 1 3 -1 -3 5 3 6 7
+    //             输出 -1 -3 -3 -3 3 3 / 3 3 5 5 6 7
+    int n, k;
+    if (!(cin >> n >> k)) return 0;
+    MultiWindowMinMax<int> mw({k});
+    vector<int> mins, maxs;
+    for (int i = 0; i < n; i++) {
+        int x;
+        cin >> x;
+        mw.push(x);
+        if (mw.full(0)) mins.push_back(mw.min(0)), maxs.push_back(mw.max(0));
+    }
+    for (int x : mins) cout << x << " ";
+    cout << endl;
+    for (int x : maxs) cout << x << " ";
+    cout << endl;
+    return 0;
+}
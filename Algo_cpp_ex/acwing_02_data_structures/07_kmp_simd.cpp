@@ -0,0 +1,368 @@
+/*
+ * ============================================
+ *   单模式串快速查找 - SIMD 首尾字节过滤 + memcmp 验证 + KMP 兜底 + 流式分块
+ *   基于 07_kmp.cpp (ne[] 状态机)
+ *   题目来源: AcWing 831. KMP字符串
+ * ============================================
+ *
+ * 【原版的局限】
+ *   - KMP 一次只吃一个字节，每个字节一次分支：再快也就几百 MB/s；
+ *   - 文本要整篇读进 char s[M]：几 GB 的日志文件放不下。
+ *
+ * 【SIMD 首尾字节过滤】
+ *   模式串 P 长 n。文本位置 i 能匹配，至少要 s[i] == P[0] 且 s[i+n-1] == P[n-1]。
+ *   一次比 32 个位置 (AVX2)：
+ *
+ *     F = 32 个 P[0]      E = 32 个 P[n-1]
+ *     A = s[i .. i+31]    B = s[i+n-1 .. i+n+30]
+ *     mask = movemask((A == F) & (B == E))     每一位对应一个候选起点
+ *
+ *   随机文本里首尾同时撞上的概率约 1/字母表^2，绝大多数 32 字节块 mask == 0，
+ *   一次比较就整块跳过；剩下的候选用 memcmp 核对中间 n-2 个字节。
+ *
+ * 【KMP 兜底】
+ *   过滤器怕的是"首尾老是对上、中间对不上"的文本 (P = aaa...ab, S = aaaa...)：
+ *   每个位置都是候选，每次 memcmp 都要比 n 个字节，退化成 O(nm)。
+ *   所以记一笔账：每扫过一个字节存 2 分，每做一次 memcmp 花 n 分，
+ *   余额透支就在当前候选位置切换成 KMP 跑完这一段，最坏情况仍是 O(m)。
+ *
+ * 【运行时选指令集】
+ *   同一个二进制在不同机器上跑：AVX2 (32 字节) > SSE2 (16 字节) > 标量 (memchr 找首字节)，
+ *   启动时用 __builtin_cpu_supports 选一次，各版本用 target 属性单独编译，不需要 -mavx2。
+ *   (SSE4.2 的 pcmpestri 做子串查找延迟高，比 SSE2 的 cmpeq 过滤还慢，这里不用。)
+ *
+ * 【流式：跨块的部分匹配】
+ *   Stream 只存 KMP 的状态 j (= 已经读过的文本后缀和 P 前缀最长重合多少)：
+ *     1. 新块的前 n-1 个字节先用 KMP 从 j 接着走，跨块的匹配就在这里报告
+ *        (它们都在上一块开头，不可能整个落在新块里)；
+ *     2. 整块交给 SIMD 找块内的匹配；
+ *     3. 块尾 n-1 个字节再用 KMP 从 0 走一遍，得到下一块要接的 j。
+ *   每块额外 O(n)，文本不用整篇留在内存里。
+ *
+ * 【复杂度】
+ *   - 预处理：O(n)
+ *   - 查找：最坏 O(m)，随机文本下约 m / 32 次向量比较 (受内存带宽限制)
+ *   - 空间：O(n)，和文本长度无关
+ *
+ * 【用法】
+ *   ./a.out                          AcWing 831：输入 n P m S，输出所有匹配起点 (从 0 开始)
+ *   ./a.out scan <模式串> < 文件      流式扫 stdin，输出匹配个数
+ *   ./a.out bench [文本 MB]
+ *   编译: g++ -std=c++17 -O2 07_kmp_simd.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <unistd.h>
+#include "../bench.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86 1
+#endif
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 查找器 ==========
+struct Searcher {
+    enum Isa { SCALAR, SSE2, AVX2 };
+
+    string p;
+    int n;
+    vector<int> ne; // 07 的 ne[]：ne[i] = P[1..i] 的最长相等真前后缀 (这里 p 从 0 存，p[j] 就是原版的 p[j+1])
+    Isa isa;
+
+    static Isa best_isa() {
+#ifdef HAVE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return AVX2;
+        if (__builtin_cpu_supports("sse2")) return SSE2;
+#endif
+        return SCALAR;
+    }
+    static const char* isa_name(Isa x) { return x == AVX2 ? "avx2" : x == SSE2 ? "sse2" : "scalar"; }
+
+    explicit Searcher(const string& pat, Isa force = best_isa()) : p(pat), n(pat.size()), ne(n + 1, 0), isa(force) {
+        for (int i = 1, j = 0; i < n; i++) {
+            while (j && p[i] != p[j]) j = ne[j];
+            if (p[i] == p[j]) j++;
+            ne[i + 1] = j;
+        }
+    }
+
+    // KMP 从状态 j 接着走 s[0, len)，返回走完后的 j；匹配起点 = base + 下标
+    template <class Report>
+    int kmp(const char* s, size_t len, int j, LL base, Report& report) const {
+        for (size_t i = 0; i < len; i++) {
+            while (j && s[i] != p[j]) j = ne[j];
+            if (s[i] == p[j]) j++;
+            if (j == n) {
+                report(base + (LL)i + 1 - n);
+                j = ne[j];
+            }
+        }
+        return j;
+    }
+
+    // 找 s[0, len) 里所有完整的匹配
+    template <class Report>
+    void find_all(const char* s, size_t len, LL base, Report& report) const {
+        if (n == 0 || len < (size_t)n) return;
+#ifdef HAVE_X86
+        if (isa == AVX2) return scan_avx2(s, len, base, report);
+        if (isa == SSE2) return scan_sse2(s, len, base, report);
+#endif
+        scan_scalar(s, len, base, report);
+    }
+
+    // 候选位置 i 首尾已经对上：核对中间。记账见开头
+    bool verify(const char* s) const { return n <= 2 || memcmp(s + 1, p.data() + 1, n - 2) == 0; }
+
+    template <class Report>
+    void scan_scalar(const char* s, size_t len, LL base, Report& report) const {
+        const char first = p[0], last = p[n - 1];
+        const char* end = s + len - n + 1; // 候选起点 [s, end)
+        LL budget = 4096;
+        const char* paid = s; // [s, paid) 扫过的字节已经记过账
+        for (const char* q = s; q < end; q++) {
+            q = (const char*)memchr(q, first, end - q);
+            if (!q) return;
+            if (q[n - 1] != last) continue;
+            budget += 2 * (q - paid) - n, paid = q;
+            if (budget < 0) {
+                kmp(q, s + len - q, 0, base + (q - s), report);
+                return;
+            }
+            if (verify(q)) report(base + (q - s));
+        }
+    }
+
+#ifdef HAVE_X86
+    // 处理一个 W 字节块的候选 mask；透支返回 false，调用方已经交给 KMP 了
+    template <class Report>
+    bool take(uint32_t mask, const char* s, size_t i, size_t len, LL base, LL& budget, Report& report) const {
+        while (mask) {
+            size_t q = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+            if ((budget -= n) < 0) {
+                kmp(s + q, len - q, 0, base + q, report);
+                return false;
+            }
+            if (verify(s + q)) report(base + q);
+        }
+        return true;
+    }
+
+    // 块走不完的尾巴 (剩下不到 W 个候选起点)：逐个位置
+    template <class Report>
+    void tail(const char* s, size_t i, size_t len, LL base, LL budget, Report& report) const {
+        const char first = p[0], last = p[n - 1];
+        for (; i + n <= len; i++)
+            if (s[i] == first && s[i + n - 1] == last) {
+                if ((budget -= n) < 0) {
+                    kmp(s + i, len - i, 0, base + i, report);
+                    return;
+                }
+                if (verify(s + i)) report(base + i);
+            }
+    }
+
+    template <class Report>
+    __attribute__((target("avx2"))) void scan_avx2(const char* s, size_t len, LL base, Report& report) const {
+        const __m256i F = _mm256_set1_epi8(p[0]), E = _mm256_set1_epi8(p[n - 1]);
+        LL budget = 4096;
+        size_t i = 0;
+        for (; i + n - 1 + 32 <= len; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(s + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(s + i + n - 1));
+            uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, F), _mm256_cmpeq_epi8(b, E)));
+            budget += 64;
+            if (__builtin_expect(mask != 0, 0) && !take(mask, s, i, len, base, budget, report)) return;
+        }
+        tail(s, i, len, base, budget, report);
+    }
+
+    template <class Report>
+    void scan_sse2(const char* s, size_t len, LL base, Report& report) const {
+        const __m128i F = _mm_set1_epi8(p[0]), E = _mm_set1_epi8(p[n - 1]);
+        LL budget = 4096;
+        size_t i = 0;
+        for (; i + n - 1 + 16 <= len; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(s + i + n - 1));
+            uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, F), _mm_cmpeq_epi8(b, E)));
+            budget += 32;
+            if (__builtin_expect(mask != 0, 0) && !take(mask, s, i, len, base, budget, report)) return;
+        }
+        tail(s, i, len, base, budget, report);
+    }
+#endif
+
+    // 流式匹配状态：同一个查找器可以同时给多条流用
+    struct Stream {
+        const Searcher* se;
+        int j = 0;  // 已读文本的后缀和 P 的前缀最长重合多少 (KMP 状态)
+        LL pos = 0; // 已经读过的字节数
+
+        explicit Stream(const Searcher& s) : se(&s) {}
+
+        // 喂一块数据，每个匹配调用 report(匹配起点在整个流里的下标)
+        template <class Report>
+        void feed(const char* s, size_t len, Report&& report) {
+            int n = se->n;
+            if (n == 0) return;
+            size_t head = min(len, (size_t)n - 1);
+            j = se->kmp(s, head, j, pos, report); // 1. 跨块的匹配
+            if (len > head) {
+                se->find_all(s, len, pos, report); // 2. 块内的匹配
+                auto none = [](LL) {};
+                j = se->kmp(s + len - head, head, 0, 0, none); // 3. 给下一块留状态
+            }
+            pos += len;
+        }
+        template <class Report>
+        void feed(const string& s, Report&& report) { feed(s.data(), s.size(), report); }
+    };
+};
+
+// ========== 基准测试 ==========
+// 07 原版 KMP (对照组)
+void kmp_plain(const string& pat, const string& text, LL& cnt, LL& sum) {
+    int n = pat.size(), m = text.size();
+    const char* p = pat.data() - 1;
+    const char* s = text.data() - 1;
+    vector<int> ne(n + 1, 0);
+    for (int i = 2, j = 0; i <= n; i++) {
+        while (j && p[i] != p[j + 1]) j = ne[j];
+        if (p[i] == p[j + 1]) j++;
+        ne[i] = j;
+    }
+    for (int i = 1, j = 0; i <= m; i++) {
+        while (j && s[i] != p[j + 1]) j = ne[j];
+        if (s[i] == p[j + 1]) j++;
+        if (j == n) {
+            cnt++, sum += i - n;
+            j = ne[j];
+        }
+    }
+}
+
+void run_case(const char* title, const string& pat, const string& text) {
+    printf("%s (pattern length %zu, text %.0f MB)\n", title, pat.size(), text.size() / 1048576.0);
+    double mb = text.size() / 1048576.0;
+    LL cnt0 = 0, sum0 = 0;
+    auto st = chrono::steady_clock::now();
+    kmp_plain(pat, text, cnt0, sum0);
+    double t = bench::elapsed_ms(st);
+    printf("  %-30s %9.1f ms %8.0f MB/s  (%lld matches)\n", "KMP (07, original)", t, mb / t * 1e3, cnt0);
+
+    {
+        st = chrono::steady_clock::now();
+        LL cnt = 0, sum = 0;
+        for (size_t q = text.find(pat); q != string::npos; q = text.find(pat, q + 1)) cnt++, sum += q;
+        t = bench::elapsed_ms(st);
+        printf("  %-30s %9.1f ms %8.0f MB/s%s\n", "std::string::find", t, mb / t * 1e3,
+               bench::check(cnt == cnt0 && sum == sum0));
+    }
+
+    Searcher::Isa best = Searcher::best_isa();
+    for (int k = 0; k <= best; k++) {
+        Searcher se(pat, (Searcher::Isa)k);
+        LL cnt = 0, sum = 0;
+        auto rep = [&](LL q) { cnt++, sum += q; };
+        st = chrono::steady_clock::now();
+        se.find_all(text.data(), text.size(), 0, rep);
+        t = bench::elapsed_ms(st);
+        string name = string("filter + KMP fallback, ") + Searcher::isa_name((Searcher::Isa)k);
+        printf("  %-30s %9.1f ms %8.0f MB/s%s\n", name.c_str(), t, mb / t * 1e3,
+               bench::check(cnt == cnt0 && sum == sum0));
+    }
+
+    {
+        // 1MB 块流式 + 随机大小的块，结果都要和一次扫完一样
+        Searcher se(pat);
+        LL cnt = 0, sum = 0;
+        st = chrono::steady_clock::now();
+        Searcher::Stream sm(se);
+        for (size_t i = 0; i < text.size(); i += 1 << 20)
+            sm.feed(text.data() + i, min(text.size() - i, (size_t)1 << 20), [&](LL q) { cnt++, sum += q; });
+        t = bench::elapsed_ms(st);
+        mt19937 rng(831);
+        LL cnt2 = 0, sum2 = 0;
+        Searcher::Stream sm2(se);
+        for (size_t i = 0; i < text.size();) {
+            size_t len = min(text.size() - i, (size_t)(rng() % 3 ? rng() % (2 * pat.size() + 1) : rng() % 100000));
+            sm2.feed(text.data() + i, len, [&](LL q) { cnt2++, sum2 += q; });
+            i += len;
+        }
+        bool ok = cnt == cnt0 && sum == sum0 && cnt2 == cnt0 && sum2 == sum0;
+        printf("  %-30s %9.1f ms %8.0f MB/s%s\n", "stream, 1MB chunks", t, mb / t * 1e3, bench::check(ok));
+    }
+
+    // 内存带宽参照：memchr 找一个不存在的字节
+    st = chrono::steady_clock::now();
+    const void* r = memchr(text.data(), '\x01', text.size());
+    t = bench::elapsed_ms(st);
+    printf("  %-30s %9.1f ms %8.0f MB/s%s\n", "memchr (bandwidth reference)", t, mb / t * 1e3, r ? " ?" : "");
+}
+
+void benchmark(int mb) {
+    mt19937 rng(20260121);
+    size_t m = (size_t)mb << 20;
+
+    // 1. 日志：小写字母 + 空格，中间埋一些目标串
+    string pat = "connection reset by peer";
+    string text;
+    text.reserve(m);
+    while (text.size() < m) {
+        if (rng() % 5000 == 0) text += pat;
+        else text += rng() % 6 ? char('a' + rng() % 26) : ' ';
+    }
+    text.resize(m);
+    run_case("log text", pat, text);
+
+    // 2. 过滤器的噩梦：首尾几乎处处对上，要靠 KMP 兜底
+    string bad(64, 'a');
+    bad[62] = 'b';
+    string text2(m, 'a');
+    for (size_t i = 0; i < m; i += 1 << 16) text2[i] = 'b';
+    run_case("adversarial a..aba in aaaa", bad, text2);
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int mb = argc >= 3 ? atoi(argv[2]) : 256;
+        benchmark(mb);
+        return 0;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "scan") == 0) {
+        Searcher se(argv[2]);
+        Searcher::Stream sm(se);
+        LL cnt = 0;
+        vector<char> buf(1 << 20);
+        ssize_t got;
+        while ((got = read(0, buf.data(), buf.size())) > 0) sm.feed(buf.data(), got, [&](LL) { cnt++; });
+        printf("%lld\n", cnt);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 831: 输入 3 / aba / 5 / ababa，输出 0 2
+    int n, m;
+    string p, s;
+    if (!(cin >> n >> p >> m >> s)) return 0;
+    Searcher se(p);
+    Searcher::Stream sm(se);
+    sm.feed(s, [&](LL q) { cout << q << " "; });
+    cout << "\n";
+    return 0;
+}
@@ -0,0 +1,540 @@
+/*
+ * ============================================
+ *   双数组 Trie (Double-Array Trie) + 尾串压缩 - 建好后冻结成紧凑只读字典
+ *   基于 08_trie.cpp (son[N][26], cnt[], idx)
+ *   题目来源: AcWing 835. Trie字符串统计
+ * ============================================
+ *
+ * 【原版的内存账】
+ *   son[N][26] 每个节点 26 个 int = 104 字节 (再加 cnt 4 字节)，
+ *   可是大多数节点只有 1 个孩子：25 扇门都是空的。
+ *   随机单词每个 key 要 5~6 个节点 -> 每个 key 600 多字节，5000 万个 key 要 30GB。
+ *
+ * 【双数组：把 26 扇门叠进两个一维数组】
+ *   每个节点 s 只存一个 base[s]，孩子 c 放在 t = base[s] + c。
+ *   不同节点的孩子会落在同一个数组里，靠 check[t] == s 认领"这格是不是我的孩子"：
+ *
+ *     son[s][c] != 0   <=>   check[base[s] + c] == s
+ *
+ *   建的时候给每个节点找一个 base，让它所有孩子要去的格子都空着：空闲格子串成链表，
+ *   只在已占用区域最后 1024 格里找 (更靠前的空洞四周都挤满了，白试)，试 64 次不行就放到最后面。
+ *   稀疏的节点互相插空，格子利用率 90% 以上，一个节点约 8 字节。
+ *
+ * 【尾串压缩 (TAIL)】
+ *   一棵子树里只剩一个单词时，下面就是一条没有分叉的链，没必要一个字符一个格子。
+ *   这条链直接存成尾串：tail = "剩下的字符" + '\0' + 单词编号 (4 字节)，
+ *   链的第一个节点 base 存负数 -(尾串偏移 + 1) 表示"到叶子了，去 tail 里比"。
+ *   单词在中间节点结束 (插了 "ab" 又插了 "abc") 时，用编码 0 的孩子 (结束标记) 挂一个空尾串。
+ *   于是每个单词恰好对应一个叶子、一个编号 id，出现次数放在 cnt[id]。
+ *
+ *     字符编码: 结束 = 0, 'a' = 1, ..., 'z' = 26     (结束排最前，枚举自然是字典序)
+ *
+ * 【流程：从排好序的单词直接建，不经过 son[][]】
+ *   5000 万个 key 的 son[][] 本身就放不下，所以不能"先 insert 再冻结"。
+ *   单词按字典序排好后，有共同前缀的单词挨在一起，trie 的一个节点就是一段区间：
+ *
+ *     [lo, hi) 前 d 个字符相同  ->  按第 d 个字符 (没有了算结束标记 0) 切成连续的几段，
+ *                                  每段是一个孩子；段里只剩一种单词就是叶子 (写尾串)
+ *
+ *   用一个栈按 DFS 做下去 (栈深 <= 最长单词，每层最多 27 个)，叶子弹出时才分配 id，
+ *   所以 id 恰好是单词去重后的字典序名次。峰值内存 = 单词本身 + 双数组。
+ *   build(ArrayTrie) 从原版 son[][] 冻结，只留作对照组。
+ *   建好之后只读：query(str) 计数、enumerate(前缀) 枚举。
+ *   AcWing 835 是插入和查询交替的：先把所有插入的串排序建字典得到各自的 id，
+ *   再按原顺序重放，插入 cnt[id]++、查询读 cnt[id]。
+ *
+ * 【复杂度】
+ *   - 查询：O(串长)，每个字符一次 base 加法 + 一次 check 比较
+ *   - 枚举：O(结果总长度 + 途经节点数 x 27)
+ *   - 空间：约 8 字节 x 分叉节点数 + 尾串长度 + 4 字节 x key 数
+ *
+ * 【用法】
+ *   ./a.out                        AcWing 835：n 个操作 "I x" / "Q x"
+ *   ./a.out dict                   先读 n 个单词建字典，再 q 个操作 "Q x" 计数 / "P x" 按字典序列出前缀是 x 的单词
+ *   ./a.out bench [key 数] [查询数]
+ *   编译: g++ -std=c++17 -O2 08_trie_double_array.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 08 原版 (对照组) ==========
+struct ArrayTrie {
+    vector<array<int, 26>> son;
+    vector<int> cnt;
+    int idx = 0;
+
+    ArrayTrie() : son(1), cnt(1, 0) { son[0].fill(0); }
+
+    void insert(const char* str) {
+        int p = 0;
+        for (int i = 0; str[i]; i++) {
+            int u = str[i] - 'a';
+            if (!son[p][u]) {
+                son[p][u] = ++idx;
+                son.emplace_back();
+                son.back().fill(0);
+                cnt.push_back(0);
+            }
+            p = son[p][u];
+        }
+        cnt[p]++;
+    }
+
+    int query(const char* str) const {
+        int p = 0;
+        for (int i = 0; str[i]; i++) {
+            int u = str[i] - 'a';
+            if (!son[p][u]) return 0;
+            p = son[p][u];
+        }
+        return cnt[p];
+    }
+
+    size_t bytes() const { return son.size() * sizeof(son[0]) + cnt.size() * sizeof(int); }
+};
+
+// ========== 双数组 Trie ==========
+struct DoubleArrayTrie {
+    vector<int> base;  // >= 0: 孩子 c 在 base + c；< 0: 叶子，尾串在 tail[-base - 1]
+    vector<int> check; // check[t] = 父节点，-1 表示空格
+    string tail;       // 每个叶子: 剩下的字符 + '\0' + 4 字节 id
+    vector<int> cnt;   // cnt[id]: 这个单词的出现次数
+    int keys = 0;
+
+    // ---------- 构建 ----------
+    // 空闲格子的双向链表 (只在构建时用)
+    vector<int> nf, pf;
+    int free_head = -1;
+    int frontier = 0; // [frontier, 末尾) 全是空格
+    static const int WINDOW = 1024, TRIES = 64; // 只在已占用区域最后 WINDOW 格里找空位，每个节点最多试 TRIES 个
+
+    void grow(int sz) {
+        int old = base.size();
+        if (sz <= old) return;
+        sz = max(sz, old * 2);
+        base.resize(sz, 0), check.resize(sz, -1), nf.resize(sz), pf.resize(sz);
+        for (int i = old; i < sz; i++) { // 新格子挂到循环链表尾部 (pf[head] 是尾)，链表保持下标递增
+            if (free_head == -1) {
+                free_head = nf[i] = pf[i] = i;
+            } else {
+                int last = pf[free_head];
+                nf[last] = i, pf[i] = last;
+                nf[i] = free_head, pf[free_head] = i;
+            }
+        }
+    }
+
+    // 占用空格 t
+    void occupy(int t, int parent) {
+        check[t] = parent;
+        frontier = max(frontier, t + 1);
+        unlink(t);
+    }
+
+    void unlink(int t) {
+        if (nf[t] == t) {
+            free_head = -1;
+        } else {
+            nf[pf[t]] = nf[t], pf[nf[t]] = pf[t];
+            if (free_head == t) free_head = nf[t];
+        }
+    }
+
+    // 找一个 base，让 codes 里每个 base + c 都空着
+    int find_base(const vector<int>& codes) {
+        // 太靠前的空格周围已经挤满，再也塞不进带好几个孩子的节点：移出链表不再尝试
+        while (free_head != -1 && free_head < frontier - WINDOW) unlink(free_head);
+        int c0 = codes[0], tries = 0;
+        for (int pos = free_head; pos != -1 && tries < TRIES; tries++) {
+            int b = pos - c0;
+            if (b >= 0) {
+                grow(b + codes.back() + 1);
+                bool ok = true;
+                for (int c : codes)
+                    if (check[b + c] != -1) {
+                        ok = false;
+                        break;
+                    }
+                if (ok) return b;
+            }
+            pos = nf[pos];
+            if (pos == free_head) break;
+        }
+        // 前面挤不下：放到已占用区域的后面，那里全是空格
+        int b = max(frontier - c0, 0);
+        grow(b + codes.back() + 1);
+        return b;
+    }
+
+    // 叶子：写尾串 (word 从第 from 个字符起)，返回 base 要存的负数
+    int add_leaf(const string& word, size_t from, int id) {
+        int off = tail.size();
+        tail.append(word, from, string::npos);
+        tail += '\0';
+        tail.append((const char*)&id, 4);
+        return -off - 1;
+    }
+
+    void start_build() {
+        base.clear(), check.clear(), nf.clear(), pf.clear(), tail.clear(), cnt.clear();
+        free_head = -1, frontier = 0, keys = 0;
+        grow(1024);
+        occupy(0, 0); // 根
+    }
+
+    // 给格子 s 的孩子们 (编码 codes，递增) 找位置并占住，返回 base
+    int place(int s, const vector<int>& codes) {
+        int b = find_base(codes);
+        base[s] = b;
+        for (int c : codes) occupy(b + c, s);
+        return b;
+    }
+
+    // 收尾：数组截到最后一个占用的格子，再留 27 格，查询时 base + c 不用判越界
+    void finish_build() {
+        base.resize(frontier + 27, 0), check.resize(frontier + 27, -1);
+        base.shrink_to_fit(), check.shrink_to_fit(), tail.shrink_to_fit();
+        vector<int>().swap(nf), vector<int>().swap(pf);
+    }
+
+    // ⚡ 从按字典序排好的单词 (可以重复，重复几次就计几次) 直接建
+    void build(const vector<string>& sorted) {
+        start_build();
+        struct Item {
+            int lo, hi, d, s; // 单词区间 [lo, hi) 前 d 个字符相同，对应格子 s
+        };
+        vector<Item> stk;
+        vector<int> codes, cut;
+        int n = sorted.size();
+        if (n) stk.push_back({0, n, 0, 0});
+        else base[0] = 0; // 空字典
+        while (!stk.empty()) {
+            Item it = stk.back();
+            stk.pop_back();
+            if (it.s && sorted[it.lo] == sorted[it.hi - 1]) { // 只剩一种单词：叶子 (根除外)
+                cnt.push_back(it.hi - it.lo);
+                base[it.s] = add_leaf(sorted[it.lo], it.d, keys++);
+                continue;
+            }
+            // 按第 d 个字符切段：cut[k] 是第 k 段的开头
+            codes.clear(), cut.clear();
+            for (int i = it.lo; i < it.hi; i++) {
+                const string& w = sorted[i];
+                int c = (int)w.size() == it.d ? 0 : code(w[it.d]);
+                if (codes.empty() || codes.back() != c) codes.push_back(c), cut.push_back(i);
+            }
+            cut.push_back(it.hi);
+            int b = place(it.s, codes);
+            // 倒着压栈，弹出时就是字典序；结束标记那段长度就是 d，尾串为空
+            for (int k = codes.size() - 1; k >= 0; k--)
+                stk.push_back({cut[k], cut[k + 1], it.d + (codes[k] != 0), b + codes[k]});
+        }
+        finish_build();
+    }
+
+    // 从原版 son[][] 冻结 (对照组：要先把整棵 son[][] 建出来)
+    void build(const ArrayTrie& tr) {
+        int n = tr.idx + 1;
+        // ends[u]：子树里有几个单词结尾 (只关心 0 / 1 / 多个)，孩子编号都比父亲大，倒着推
+        vector<uint8_t> ends(n, 0);
+        for (int u = n - 1; u >= 0; u--) {
+            int e = tr.cnt[u] > 0;
+            for (int c = 0; c < 26 && e < 2; c++)
+                if (tr.son[u][c]) e += ends[tr.son[u][c]];
+            ends[u] = min(e, 2);
+        }
+
+        start_build();
+
+        // 单词只剩一个的子树：顺着唯一的链收集尾串
+        auto leaf_of = [&](int v, string rest) {
+            while (!tr.cnt[v]) {
+                int c = 0;
+                while (!tr.son[v][c]) c++;
+                rest += char('a' + c), v = tr.son[v][c];
+            }
+            cnt.push_back(tr.cnt[v]);
+            return add_leaf(rest, 0, keys++);
+        };
+
+        // BFS：(原 trie 节点, 双数组格子)
+        vector<pair<int, int>> q;
+        q.push_back({0, 0});
+        vector<int> codes;
+        for (size_t hh = 0; hh < q.size(); hh++) {
+            auto [u, s] = q[hh]; // 进队的都是至少两个单词的子树 (根除外)
+            codes.clear();
+            if (tr.cnt[u]) codes.push_back(0);
+            for (int c = 0; c < 26; c++)
+                if (tr.son[u][c]) codes.push_back(c + 1);
+            if (codes.empty()) { // 空字典
+                base[s] = 0;
+                continue;
+            }
+            int b = place(s, codes);
+            for (int c : codes) {
+                int t = b + c;
+                if (c == 0) {
+                    cnt.push_back(tr.cnt[u]);
+                    base[t] = add_leaf("", 0, keys++);
+                } else {
+                    int v = tr.son[u][c - 1];
+                    if (ends[v] == 1) base[t] = leaf_of(v, "");
+                    else q.push_back({v, t});
+                }
+            }
+        }
+        finish_build();
+    }
+
+    // ---------- 查询 ----------
+    static int code(char ch) { return ch - 'a' + 1; }
+
+    int leaf_id(int s) const {
+        int id;
+        memcpy(&id, tail.data() + (-base[s] - 1) + strlen(tail.data() + (-base[s] - 1)) + 1, 4);
+        return id;
+    }
+
+    // 单词的 id，不在字典里返回 -1
+    int find(const char* str, int len) const {
+        int s = 0;
+        for (int i = 0; i < len; i++) {
+            if (base[s] < 0) { // 到叶子了：剩下的必须和尾串一模一样
+                const char* t = tail.data() + (-base[s] - 1);
+                int k = 0;
+                while (i + k < len && t[k] == str[i + k]) k++; // t 以 '\0' 结尾，比到头自然停下
+                if (i + k < len || t[k]) return -1;
+                int id;
+                memcpy(&id, t + k + 1, 4);
+                return id;
+            }
+            int t = base[s] + code(str[i]);
+            if (check[t] != s) return -1;
+            s = t;
+        }
+        if (base[s] >= 0) { // 走完了还在分叉节点：看有没有结束标记
+            int t = base[s];
+            if (check[t] != s || t == s) return -1;
+            s = t;
+        }
+        if (tail[-base[s] - 1]) return -1; // 尾串还没比完
+        return leaf_id(s);
+    }
+    int find(const string& str) const { return find(str.data(), str.size()); }
+
+    int query(const string& str) const {
+        int id = find(str);
+        return id < 0 ? 0 : cnt[id];
+    }
+
+    // 按字典序列出所有以 prefix 开头的单词：report(单词, 出现次数)
+    template <class Report>
+    void enumerate(const string& prefix, Report&& report) const {
+        string key = prefix;
+        int s = 0;
+        for (size_t i = 0; i < prefix.size(); i++) {
+            if (base[s] < 0) { // 前缀在尾串中间结束：最多一个单词
+                const char* t = tail.data() + (-base[s] - 1);
+                size_t rest = prefix.size() - i;
+                if (strlen(t) < rest || memcmp(t, prefix.data() + i, rest)) return;
+                key = prefix.substr(0, i) + t;
+                report(key, cnt[leaf_id(s)]);
+                return;
+            }
+            int t = base[s] + code(prefix[i]);
+            if (check[t] != s) return;
+            s = t;
+        }
+        dfs(s, key, report);
+    }
+
+    template <class Report>
+    void dfs(int s, string& key, Report& report) const {
+        if (base[s] < 0) {
+            size_t n = key.size();
+            key += tail.data() + (-base[s] - 1);
+            report(key, cnt[leaf_id(s)]);
+            key.resize(n);
+            return;
+        }
+        int b = base[s];
+        for (int c = 0; c <= 26; c++) {
+            int t = b + c;
+            if (check[t] != s || t == s) continue;
+            if (c) key += char('a' + c - 1);
+            dfs(t, key, report);
+            if (c) key.pop_back();
+        }
+    }
+
+    size_t bytes() const { return (base.size() + check.size()) * sizeof(int) + tail.size() + cnt.size() * sizeof(int); }
+};
+
+// ========== 基准测试 ==========
+// 原版上的前缀枚举 (对照组，校验用)
+void array_enum(const ArrayTrie& tr, int p, string& key, vector<pair<string, int>>& out) {
+    if (tr.cnt[p]) out.push_back({key, tr.cnt[p]});
+    for (int c = 0; c < 26; c++)
+        if (tr.son[p][c]) {
+            key += char('a' + c);
+            array_enum(tr, tr.son[p][c], key, out);
+            key.pop_back();
+        }
+}
+
+void benchmark(int K, int Q) {
+    mt19937 rng(20260122);
+    // 单词：长 5~12，前两个字母从少数几个里挑 (模拟真实词典有很多公共前缀)
+    auto word = [&]() {
+        string s;
+        int len = 5 + rng() % 8;
+        for (int i = 0; i < len; i++) s += char('a' + (i < 2 ? rng() % 6 : rng() % 26));
+        return s;
+    };
+    vector<string> keys(K);
+    for (auto& s : keys) s = word();
+
+    auto st = chrono::steady_clock::now();
+    ArrayTrie tr;
+    for (auto& s : keys) tr.insert(s.c_str());
+    double t_ins = bench::elapsed_ms(st);
+
+    st = chrono::steady_clock::now();
+    DoubleArrayTrie da;
+    da.build(tr);
+    double t_build = bench::elapsed_ms(st);
+
+    // 不经过 son[][]：排序后按区间直接建，峰值是单词本身 + 双数组
+    st = chrono::steady_clock::now();
+    vector<string> sorted = keys;
+    sort(sorted.begin(), sorted.end());
+    double t_sort = bench::elapsed_ms(st);
+    st = chrono::steady_clock::now();
+    DoubleArrayTrie ds;
+    ds.build(sorted);
+    double t_sorted = bench::elapsed_ms(st);
+    size_t key_bytes = sorted.capacity() * sizeof(string);
+    for (auto& w : sorted)
+        if (w.capacity() > 15) key_bytes += w.capacity() + 1; // 超过短串优化的才另占堆
+
+    printf("%d keys (%d distinct), %d trie nodes\n", K, da.keys, tr.idx + 1);
+    bench::row("son[][] inserts", t_ins, true, 32);
+    printf("  %-32s %9.1f ms  (%zu cells, %zu tail bytes)\n", "freeze son[][] to double array", t_build,
+           da.base.size(), da.tail.size());
+    bench::row("sort keys", t_sort, true, 32);
+    printf("  %-32s %9.1f ms  (%zu cells)%s\n", "build from sorted keys", t_sorted, ds.base.size(),
+           bench::check(ds.keys == da.keys));
+    printf("  %-32s %9.1f bytes/key  (50M keys: %.1f GB)\n", "son[][] memory", (double)tr.bytes() / K,
+           tr.bytes() * 50e6 / K / 1e9);
+    printf("  %-32s %9.1f bytes/key  (50M keys: %.1f GB)\n", "double array memory", (double)ds.bytes() / K,
+           ds.bytes() * 50e6 / K / 1e9);
+    printf("  %-32s %9.1f bytes/key  (50M keys: %.1f GB)\n", "peak: sorted keys + double array",
+           (double)(key_bytes + ds.bytes()) / K, (key_bytes + ds.bytes()) * 50e6 / K / 1e9);
+
+    // 查询：一半在字典里，一半随机
+    vector<string> qs(Q);
+    for (int i = 0; i < Q; i++) qs[i] = i % 2 ? keys[rng() % K] : word();
+    st = chrono::steady_clock::now();
+    LL s1 = 0;
+    for (auto& s : qs) s1 += tr.query(s.c_str());
+    double t1 = bench::elapsed_ms(st);
+    st = chrono::steady_clock::now();
+    LL s2 = 0;
+    for (auto& s : qs) s2 += ds.query(s);
+    double t2 = bench::elapsed_ms(st);
+    LL s3 = 0;
+    for (auto& s : qs) s3 += da.query(s);
+    printf("  %-32s %9.1f ms  %6.2f M lookups/s\n", "son[][] query", t1, Q / t1 / 1e3);
+    printf("  %-32s %9.1f ms  %6.2f M lookups/s%s\n", "double array query", t2, Q / t2 / 1e3,
+           bench::check(s1 == s2 && s1 == s3));
+
+    // 前缀枚举：所有 2~3 字母的前缀里抽一些，和原版 DFS 的结果逐条比对
+    bool ok = true;
+    LL listed = 0;
+    double t_enum = 0;
+    for (int it = 0; it < 200; it++) {
+        string pre = word().substr(0, 2 + rng() % 2);
+        vector<pair<string, int>> a, b;
+        int p = 0;
+        for (char ch : pre) p = p < 0 || !tr.son[p][ch - 'a'] ? -1 : tr.son[p][ch - 'a'];
+        string key = pre;
+        if (p >= 0) array_enum(tr, p, key, a);
+        st = chrono::steady_clock::now();
+        ds.enumerate(pre, [&](const string& w, int c) { b.push_back({w, c}); });
+        t_enum += bench::elapsed_ms(st);
+        vector<pair<string, int>> c;
+        da.enumerate(pre, [&](const string& w, int k) { c.push_back({w, k}); });
+        ok &= a == b && a == c;
+        listed += b.size();
+    }
+    printf("  %-32s %9.1f ms  (200 prefixes, %lld words)%s\n", "double array enumerate", t_enum, listed,
+           bench::check(ok));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int K = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int Q = argc >= 4 ? atoi(argv[3]) : 4000000;
+        benchmark(K, Q);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    if (argc >= 2 && strcmp(argv[1], "dict") == 0) {
+        // 输入 3 / abc / abd / b / 3 / Q abc / P ab / Q ab，输出 1 / abc abd / 0
+        int n, q;
+        cin >> n;
+        vector<string> words(n);
+        for (auto& w : words) cin >> w;
+        sort(words.begin(), words.end());
+        DoubleArrayTrie da;
+        da.build(words);
+        string s, op;
+        cin >> q;
+        while (q--) {
+            cin >> op >> s;
+            if (op == "Q") {
+                cout << da.query(s) << "\n";
+            } else {
+                da.enumerate(s, [&](const string& w, int) { cout << w << " "; });
+                cout << "\n";
+            }
+        }
+        return 0;
+    }
+
+    // AcWing 835: 输入 5 / I abc / Q abc / Q ab / I ab / Q ab，输出 1 / 0 / 1
+    int n;
+    if (!(cin >> n)) return 0;
+    vector<pair<char, string>> ops(n);
+    vector<string> words;
+    for (auto& [op, s] : ops) {
+        cin >> op >> s;
+        if (op == 'I') words.push_back(s);
+    }
+    sort(words.begin(), words.end());
+    DoubleArrayTrie da;
+    da.build(words);
+    fill(da.cnt.begin(), da.cnt.end(), 0); // 重放：按时间顺序重新计数
+    for (auto& [op, s] : ops) {
+        int id = da.find(s);
+        if (op == 'I') da.cnt[id]++;
+        else cout << (id < 0 ? 0 : da.cnt[id]) << "\n";
+    }
+    return 0;
+}
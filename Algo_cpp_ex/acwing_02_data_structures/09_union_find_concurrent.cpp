@@ -0,0 +1,243 @@
+/*
+ * ============================================
+ *   并发无锁并查集 (Concurrent Union-Find) - CAS 按随机序挂接 + 松弛原子路径减半
+ *   基于 09_union_find.cpp (p[] 父节点数组, find 路径压缩)
+ *   题目来源: AcWing 836. 合并集合
+ * ============================================
+ *
+ * 【原版为什么不能多线程】
+ *   p[find(a)] = find(b) 是"读两个根、再写一个根"，两个线程同时合并时：
+ *     线程 1: A = find(a), B = find(b)        线程 2: A = find(c), C = find(d)
+ *     线程 1: p[A] = B                         线程 2: p[A] = C   <- 把线程 1 的合并覆盖掉了
+ *   递归路径压缩 p[x] = find(p[x]) 也会在别人改链的时候写回过期的值。
+ *
+ * 【挂接：CAS 只在"它还是根"时成功】
+ *   unite(a, b)：
+ *     1. a = find(a), b = find(b)，相同就结束；
+ *     2. 约定优先级低的根挂到优先级高的根下面：CAS(p[a], a -> b)；
+ *     3. CAS 失败说明 a 刚被别人挂走了 (不再是根)，回到 1 重来。
+ *   p[x] 只会从 x 变成别的值 (根 -> 非根)，不会变回来，所以 CAS 成功就一定是在合并两个根。
+ *
+ * 【优先级：随机全序代替按秩合并】
+ *   按秩/按大小合并要同时改两个字 (父节点 + 秩)，没法一次 CAS。
+ *   改成给每个点一个固定的随机优先级 prio(x) = x * 0x9E3779B1 (奇数乘法在 2^32 上是双射，不会相等)，
+ *   永远低挂高：父节点的优先级严格更大，不会成环；随机序下树高期望 O(log n)。
+ *
+ * 【路径减半 (Path Halving)：不用递归，也不怕并发】
+ *   find 沿着链往上走，每一步顺手把 p[x] 从父亲改成祖父：
+ *     x -> px -> gx    ==>    x -> gx
+ *   改之前用 CAS 确认 p[x] 还是 px；失败也无所谓 (别人已经改得更好了)，接着走。
+ *   祖父一定还在 x 的根路径上，所以任何时刻树都是合法的，用 relaxed 就够。
+ *
+ * 【并发 same_set(a, b)】
+ *   a = find(a), b = find(b) 相同就是 Yes；不同且 a 此刻还是根，就是 No
+ *   (在读 p[a] 的那一刻两点不在一起)；否则 a 被别人挂走了，重来。
+ *
+ * 【复杂度】
+ *   - unite / same_set / find：期望近乎 O(1) 均摊；只有别的线程在同一个根上成功时才会重试
+ *     (lock-free：有人重试说明有人前进了)
+ *   - 空间：n 个 atomic<uint32_t>，和原版 p[] 一样 4 字节一个
+ *
+ * 【用法】
+ *   ./a.out                           AcWing 836：n m，m 行 "M a b" / "Q a b"
+ *   ./a.out bench [n] [边数] [最大线程数]   默认 n = 10^7，10^8 条随机边
+ *   编译: g++ -std=c++17 -O2 -pthread 09_union_find_concurrent.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <cstdint>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 并发并查集 ==========
+struct ConcurrentDSU {
+    vector<atomic<uint32_t>> p;
+
+    explicit ConcurrentDSU(int n) : p(n) {
+        for (int i = 0; i < n; i++) p[i].store(i, memory_order_relaxed);
+    }
+
+    static uint32_t prio(uint32_t x) { return x * 0x9E3779B1u; }
+
+    // 路径减半：x -> px -> gx 改成 x -> gx
+    uint32_t find(uint32_t x) {
+        for (;;) {
+            uint32_t px = p[x].load(memory_order_relaxed);
+            if (px == x) return x;
+            uint32_t gx = p[px].load(memory_order_relaxed);
+            if (px != gx) p[x].compare_exchange_weak(px, gx, memory_order_relaxed);
+            x = gx;
+        }
+    }
+
+    // 返回 true 表示这次真的合并了两个集合
+    bool unite(uint32_t a, uint32_t b) {
+        for (;;) {
+            a = find(a), b = find(b);
+            if (a == b) return false;
+            if (prio(a) > prio(b)) swap(a, b);
+            uint32_t expect = a;
+            if (p[a].compare_exchange_strong(expect, b, memory_order_acq_rel)) return true;
+        }
+    }
+
+    bool same_set(uint32_t a, uint32_t b) {
+        for (;;) {
+            a = find(a), b = find(b);
+            if (a == b) return true;
+            if (p[a].load(memory_order_acquire) == a) return false;
+        }
+    }
+};
+
+// ========== 基准测试 ==========
+// 第 i 条边：按下标算出来，不用存 10^8 条边，各个版本、各个线程看到的都一样
+inline void edge(uint64_t i, uint32_t n, uint32_t& a, uint32_t& b) {
+    uint64_t z = (i + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    a = (uint32_t)((z & 0xFFFFFFFF) * n >> 32);
+    b = (uint32_t)((z >> 32) * n >> 32);
+}
+
+// 09 原版 (对照组)：递归路径压缩 + p[find(a)] = find(b)
+struct SeqDSU {
+    vector<int> p;
+    explicit SeqDSU(int n) : p(n) {
+        for (int i = 0; i < n; i++) p[i] = i;
+    }
+    int find(int x) {
+        if (p[x] != x) p[x] = find(p[x]);
+        return p[x];
+    }
+};
+
+// 两个结构划分是否相同：根到根的对应必须是一一的
+template <class FA, class FB>
+bool same_partition(int n, FA&& fa, FB&& fb) {
+    vector<int> mp(n, -1), back(n, -1);
+    for (int x = 0; x < n; x++) {
+        int ra = fa(x), rb = fb(x);
+        if (mp[ra] == -1 && back[rb] == -1) mp[ra] = rb, back[rb] = ra;
+        else if (mp[ra] != rb || back[rb] != ra) return false;
+    }
+    return true;
+}
+
+void benchmark(int n, LL m, int hw) {
+    printf("n = %d, %lld random unions, hardware threads %u\n", n, m, thread::hardware_concurrency());
+
+    SeqDSU seq(n);
+    auto st = chrono::steady_clock::now();
+    for (LL i = 0; i < m; i++) {
+        uint32_t a, b;
+        edge(i, n, a, b);
+        seq.p[seq.find(a)] = seq.find(b);
+    }
+    double t0 = bench::elapsed_ms(st);
+    printf("  %-34s %9.1f ms  %7.1f M unions/s\n", "09 original (1 thread)", t0, m / t0 / 1e3);
+
+    vector<int> thread_counts = {1};
+    for (int t = 2; t <= hw; t *= 2) thread_counts.push_back(t);
+    if (thread_counts.back() != hw) thread_counts.push_back(hw);
+
+    for (int T : thread_counts) {
+        ConcurrentDSU d(n);
+        atomic<LL> merged{0};
+        auto run = [&](auto&& job) {
+            vector<thread> pool;
+            for (int t = 1; t < T; t++) pool.emplace_back(job, t);
+            job(0);
+            for (auto& th : pool) th.join();
+        };
+        st = chrono::steady_clock::now();
+        run([&](int t) {
+            LL lo = m * t / T, hi = m * (t + 1) / T, k = 0;
+            for (LL i = lo; i < hi; i++) {
+                uint32_t a, b;
+                edge(i, n, a, b);
+                k += d.unite(a, b);
+            }
+            merged += k;
+        });
+        double t1 = bench::elapsed_ms(st);
+        bool ok = same_partition(n, [&](int x) { return seq.find(x); }, [&](int x) { return (int)d.find(x); });
+        // 每个成功的合并让集合数减一：各线程加起来必须正好等于 n - 集合数
+        LL roots = 0;
+        for (int x = 0; x < n; x++) roots += d.find(x) == (uint32_t)x;
+        ok &= merged == n - roots;
+        char name[64];
+        snprintf(name, sizeof name, "concurrent CAS + halving, %d thr", T);
+        printf("  %-34s %9.1f ms  %7.1f M unions/s%s\n", name, t1, m / t1 / 1e3, bench::check(ok));
+    }
+
+    // 合并和查询混着来：每个线程 1/4 的操作是 same_set。
+    // 查询同一对点时，先 Yes 后 No 是不可能的 (集合只会变大)，每个线程各自检查
+    {
+        int T = hw, P = 1024;
+        ConcurrentDSU d(n);
+        atomic<bool> ok{true};
+        vector<thread> pool;
+        st = chrono::steady_clock::now();
+        auto job = [&](int t) {
+            vector<char> seen(P, 0);
+            LL lo = m * t / T, hi = m * (t + 1) / T;
+            for (LL i = lo; i < hi; i++) {
+                uint32_t a, b;
+                edge(i, n, a, b);
+                if (i % 4) {
+                    d.unite(a, b);
+                } else {
+                    int k = i / 4 % P; // 固定的 P 对点轮流查
+                    edge((LL)1 << 40 | k, n, a, b);
+                    bool s = d.same_set(a, b);
+                    if (seen[k] && !s) ok = false;
+                    seen[k] |= s;
+                }
+            }
+        };
+        for (int t = 1; t < T; t++) pool.emplace_back(job, t);
+        job(0);
+        for (auto& th : pool) th.join();
+        double t2 = bench::elapsed_ms(st);
+        char name[64];
+        snprintf(name, sizeof name, "mixed 3:1 unite/same_set, %d thr", T);
+        printf("  %-34s %9.1f ms  %7.1f M ops/s%s\n", name, t2, m / t2 / 1e3, bench::check(ok));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 10000000;
+        LL m = argc >= 4 ? atoll(argv[3]) : 100000000;
+        int hw = argc >= 5 ? atoi(argv[4]) : (int)max(2u, thread::hardware_concurrency());
+        benchmark(n, m, hw);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 836: 输入 4 5 / M 1 2 / M 3 4 / Q 1 2 / Q 1 3 / Q 3 4，输出 Yes / No / Yes
+    int n, m;
+    if (!(cin >> n >> m)) return 0;
+    ConcurrentDSU d(n + 1);
+    while (m--) {
+        char op[2];
+        int a, b;
+        cin >> op >> a >> b;
+        if (op[0] == 'M') d.unite(a, b);
+        else cout << (d.same_set(a, b) ? "Yes" : "No") << "\n";
+    }
+    return 0;
+}
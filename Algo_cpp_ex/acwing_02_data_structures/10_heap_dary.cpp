@@ -0,0 +1,373 @@
+/*
+ * ============================================
+ *   缓存行对齐的 D 叉堆 (d-ary Heap) - 批量建堆 / 批量进出 / 自定义比较
+ *   基于 10_heap.cpp (h[] 数组, down / up)
+ *   题目来源: AcWing 838. 堆排序
+ * ============================================
+ *
+ * 【二叉堆大了以后慢在哪】
+ *   10 的 down(u) 每往下一层，就要去 2u 读孩子：堆比缓存大时，每层都是一次缓存缺失。
+ *   10^7 个元素的二叉堆有 23 层，一次 pop 就是十几次内存访问。
+ *
+ * 【D 叉堆：树变矮，每层的孩子挤在一个缓存行里】
+ *   每个节点 D 个孩子 (D = 4 或 8，编译期定)，层数从 log2 n 降到 log_D n (D = 8 时是三分之一)。
+ *   一个节点的 D 个孩子在数组里是连续的；再让这一组正好对齐到 64 字节，
+ *   读一层只碰一个缓存行 (8 字节元素 x 8 叉 = 64 字节)：
+ *
+ *     逻辑下标 i (根是 0)：孩子 D*i+1 .. D*i+D，父亲 (i-1)/D
+ *     物理位置 = i + (D-1)：孩子落在 D*(i+1) .. D*(i+1)+D-1，起点是 D 的倍数
+ *
+ *     物理下标   0 .. D-2 | D-1  | D .. 2D-1      | 2D .. 3D-1   ...
+ *                (空着)   | 根   | 根的 D 个孩子   | 第 1 个孩子的孩子
+ *
+ *   数组本身按 64 字节分配，于是每组兄弟都在同一个缓存行里。
+ *   down 时一层要比 D 个孩子 (比二叉多)，但都在缓存里，比一次缓存缺失便宜得多。
+ *
+ * 【预取下一层】
+ *   二叉堆的分支预测会猜一个孩子先往下读，D 叉堆猜不中。所以读一组孩子时，
+ *   把这 D 个孩子各自的孩子组 (D 个缓存行) 一起预取：选出最小孩子的同时，下一层已经在路上了。
+ *
+ * 【挖坑代替交换】
+ *   10 里 down/up 每一层 swap 一次 (3 次写)。这里把要下沉的元素先拿在手里，
+ *   坑往下走时只把孩子往上搬一次，最后把手里的元素放进坑里。
+ *
+ * 【批量操作】
+ *   - build(first, last)：和 10 一样从最后一个非叶子倒着 down，O(n)；
+ *   - push_many：一次进来的比堆还大一截时，直接追加再整体 O(n) 重建，否则逐个 push；
+ *   - pop_many(k)：k 很大时用 nth_element 选出最小的 k 个排好序，剩下的 O(n) 重建，
+ *     比 k 次 pop 少掉 k log n 次内存跳跃。
+ *
+ * 【比较器】
+ *   Cmp(a, b) 为真表示 a 先出堆：默认 less 是小根堆 (和 10 一样)，
+ *   注意这和 std::priority_queue (less 是大根堆) 正好相反。
+ *
+ * 【复杂度】
+ *   - push：O(log_D n)，pop：O(D log_D n) 次比较，但只有 O(log_D n) 次缓存缺失
+ *   - build：O(n)，pop_many(k)：O(n + k log k) 或 O(k D log_D n)，取小的
+ *
+ * 【用法】
+ *   ./a.out                        AcWing 838：n m 和 n 个数，输出最小的 m 个
+ *   ./a.out bench [初始大小] [操作数]
+ *   编译: g++ -std=c++17 -O2 10_heap_dary.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+typedef unsigned long long ULL;
+
+const size_t CACHELINE = 64;
+
+// ========== D 叉堆 ==========
+// 元素要能 memcpy (扩容时整块搬)：int、指针、pair<int, int> 这类都可以
+template <class T, int D = 8, class Cmp = less<T>>
+struct DaryHeap {
+    static_assert(D >= 2 && (D & (D - 1)) == 0, "D must be a power of two");
+    static_assert(is_trivially_copy_constructible<T>::value && is_trivially_destructible<T>::value,
+                  "elements are moved with memcpy");
+
+    static const size_t OFF = D - 1; // 逻辑下标 i 在物理位置 i + OFF
+    T* a = nullptr;                  // 物理数组，64 字节对齐
+    size_t n = 0, cap = 0;           // cap 是物理容量
+    Cmp cmp;
+
+    explicit DaryHeap(Cmp c = Cmp()) : cmp(c) {}
+    DaryHeap(const DaryHeap&) = delete;
+    DaryHeap& operator=(const DaryHeap&) = delete;
+    ~DaryHeap() { free(a); }
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    const T& top() const { return a[OFF]; }
+
+    void reserve(size_t want) {
+        want += OFF;
+        if (want <= cap) return;
+        size_t nc = max(want, cap * 2);
+        size_t bytes = (nc * sizeof(T) + CACHELINE - 1) / CACHELINE * CACHELINE;
+        T* b = (T*)aligned_alloc(CACHELINE, bytes);
+        if (!b) throw bad_alloc();
+        if (n) memcpy((void*)(b + OFF), a + OFF, n * sizeof(T));
+        free(a);
+        a = b, cap = bytes / sizeof(T);
+    }
+
+    // 物理位置 p (= i + OFF)：父亲在 (i-1)/D + OFF，孩子从 D*(i+1) 开始
+    void up(size_t i, T x) {
+        while (i) {
+            size_t f = (i - 1) / D;
+            if (!cmp(x, a[f + OFF])) break;
+            a[i + OFF] = a[f + OFF];
+            i = f;
+        }
+        a[i + OFF] = x;
+    }
+
+    // 物理位置 c 开始的一组兄弟里最先出堆的那个 (end 是物理上最后一个元素之后)。
+    // 满 D 个时两两淘汰 (没有难预测的分支)，顺手把这 D 个孩子各自的孩子组预取进来：
+    // 下一层不管走哪个孩子，那一行都已经在路上了
+    size_t best_child(size_t c, size_t end) const {
+        size_t best = c;
+        if (c + D <= end) {
+            size_t g = D * (c - OFF + 1);
+            if (g < end)
+                for (int k = 0; k < D; k++) __builtin_prefetch(a + g + D * k);
+            size_t w[D / 2];
+            for (int k = 0; k < D; k += 2) w[k / 2] = c + k + cmp(a[c + k + 1], a[c + k]);
+            for (int m = D / 2; m > 1; m /= 2)
+                for (int k = 0; k < m; k += 2) w[k / 2] = cmp(a[w[k + 1]], a[w[k]]) ? w[k + 1] : w[k];
+            best = w[0];
+        } else {
+            for (size_t k = c + 1; k < end; k++)
+                if (cmp(a[k], a[best])) best = k;
+        }
+        return best;
+    }
+
+    void down(size_t i, T x) {
+        for (;;) {
+            size_t c = D * (i + 1); // 第一个孩子的物理位置
+            size_t end = n + OFF;   // 物理上最后一个元素之后
+            if (c >= end) break;
+            size_t best = best_child(c, end);
+            if (!cmp(a[best], x)) break;
+            a[i + OFF] = a[best];
+            i = best - OFF;
+        }
+        a[i + OFF] = x;
+    }
+
+    // 按值传入：h.push(h.top()) 这种引用指向堆内部的，reserve 换缓冲区之后不会读到已释放的内存
+    void push(T x) {
+        reserve(n + 1);
+        up(n++, x);
+    }
+
+    // 堆底元素换上来几乎总要沉到最底层：坑直接沿着较小的孩子走到叶子
+    // (每层省一次和 x 的比较)，再让 x 从叶子往上浮回去
+    void pop() {
+        T x = a[OFF + --n];
+        if (!n) return;
+        size_t i = 0, end = n + OFF;
+        for (size_t c; (c = D * (i + 1)) < end;) {
+            size_t best = best_child(c, end);
+            a[i + OFF] = a[best];
+            i = best - OFF;
+        }
+        up(i, x);
+    }
+
+    // 从最后一个非叶子倒着 down：O(n)
+    void heapify() {
+        if (n < 2) return;
+        for (size_t i = (n - 2) / D + 1; i--;) down(i, a[i + OFF]);
+    }
+
+    template <class It>
+    void build(It first, It last) {
+        n = 0;
+        reserve(distance(first, last));
+        for (; first != last; ++first) a[OFF + n++] = *first;
+        heapify();
+    }
+
+    // 一批进来：比现有的 1/4 还多就整体重建 (O(n + k))，否则逐个 up
+    template <class It>
+    void push_many(It first, It last) {
+        size_t k = distance(first, last);
+        reserve(n + k);
+        if (k > n / 4) {
+            for (; first != last; ++first) a[OFF + n++] = *first;
+            heapify();
+        } else {
+            for (; first != last; ++first) up(n++, *first);
+        }
+    }
+
+    // 按出堆顺序取走前 k 个写到 out。k 超过 n/8 时 nth_element + sort + 剩下的重建
+    template <class Out>
+    Out pop_many(size_t k, Out out) {
+        k = min(k, n);
+        if (k > n / 8) {
+            T* b = a + OFF;
+            nth_element(b, b + k, b + n, cmp);
+            sort(b, b + k, cmp);
+            out = copy(b, b + k, out);
+            move(b + k, b + n, b);
+            n -= k;
+            heapify();
+        } else {
+            for (size_t i = 0; i < k; i++) *out++ = top(), pop();
+        }
+        return out;
+    }
+};
+
+// ========== 基准测试 ==========
+// 10 原版 (对照组)：1 开始的二叉小根堆，递归 down + swap
+struct BinaryHeap {
+    vector<ULL> h;
+    int sz = 0;
+    explicit BinaryHeap(size_t cap) : h(cap + 1) {}
+    void down(int u) {
+        int t = u;
+        if (u * 2 <= sz && h[u * 2] < h[t]) t = u * 2;
+        if (u * 2 + 1 <= sz && h[u * 2 + 1] < h[t]) t = u * 2 + 1;
+        if (u != t) {
+            swap(h[u], h[t]);
+            down(t);
+        }
+    }
+    void up(int u) {
+        while (u / 2 && h[u / 2] > h[u]) {
+            swap(h[u / 2], h[u]);
+            u /= 2;
+        }
+    }
+    void push(ULL x) { h[++sz] = x, up(sz); }
+    ULL top() const { return h[1]; }
+    void pop() { h[1] = h[sz--], down(1); }
+};
+
+// 混合负载：先放 n0 个，再 m 次操作，push / pop 各一半 (push 的值略大于最近出堆的值，模拟事件队列)
+struct Mix {
+    vector<ULL> init, pushes;
+    vector<char> is_push;
+};
+
+Mix make_mix(int n0, int m) {
+    mt19937_64 rng(20260125);
+    Mix w;
+    w.init.resize(n0);
+    for (auto& x : w.init) x = rng() >> 20;
+    w.is_push.resize(m);
+    for (int i = 0; i < m; i++) {
+        w.is_push[i] = rng() & 1;
+        if (w.is_push[i]) w.pushes.push_back(rng() >> 20);
+    }
+    return w;
+}
+
+template <class H>
+ULL run_mix(H& hp, const Mix& w) {
+    ULL sum = 0;
+    size_t pi = 0;
+    for (ULL x : w.init) hp.push(x);
+    for (char p : w.is_push) {
+        if (p) hp.push(w.pushes[pi++] + (sum & 0xFFFF));
+        else if (hp.size()) sum += hp.top(), hp.pop();
+    }
+    return sum;
+}
+
+struct BinaryAdapter {
+    BinaryHeap b;
+    explicit BinaryAdapter(size_t cap) : b(cap) {}
+    void push(ULL x) { b.push(x); }
+    void pop() { b.pop(); }
+    ULL top() const { return b.top(); }
+    size_t size() const { return b.sz; }
+};
+
+void benchmark(int n0, int m) {
+    Mix w = make_mix(n0, m);
+    printf("heap starts with %d keys, then %d push/pop mixes (8-byte keys)\n", n0, m);
+
+    auto report = [&](const char* name, double ms, ULL sum, ULL expect) {
+        bench::row(name, ms, sum == expect, 32);
+    };
+
+    ULL expect;
+    {
+        BinaryAdapter h(n0 + w.pushes.size());
+        auto st = chrono::steady_clock::now();
+        expect = run_mix(h, w);
+        report("binary heap (10, original)", bench::elapsed_ms(st), expect, expect);
+    }
+    {
+        priority_queue<ULL, vector<ULL>, greater<ULL>> pq;
+        auto st = chrono::steady_clock::now();
+        ULL s = run_mix(pq, w);
+        report("std::priority_queue", bench::elapsed_ms(st), s, expect);
+    }
+    {
+        DaryHeap<ULL, 4> h;
+        auto st = chrono::steady_clock::now();
+        ULL s = run_mix(h, w);
+        report("4-ary heap", bench::elapsed_ms(st), s, expect);
+    }
+    {
+        DaryHeap<ULL, 8> h;
+        auto st = chrono::steady_clock::now();
+        ULL s = run_mix(h, w);
+        report("8-ary heap (1 cache line / level)", bench::elapsed_ms(st), s, expect);
+    }
+
+    // 批量：建堆 + 一次取走 1/4
+    printf("bulk: build from %d keys, then take the smallest %d\n", n0, n0 / 4);
+    vector<ULL> got, ref(w.init);
+    sort(ref.begin(), ref.end());
+    ref.resize(n0 / 4);
+    {
+        auto st = chrono::steady_clock::now();
+        priority_queue<ULL, vector<ULL>, greater<ULL>> pq(greater<ULL>(), w.init);
+        got.clear();
+        for (int i = 0; i < n0 / 4; i++) got.push_back(pq.top()), pq.pop();
+        bench::row("std::priority_queue + pops", bench::elapsed_ms(st), got == ref, 32);
+    }
+    {
+        auto st = chrono::steady_clock::now();
+        DaryHeap<ULL, 8> h;
+        h.build(w.init.begin(), w.init.end());
+        got.clear();
+        for (int i = 0; i < n0 / 4; i++) got.push_back(h.top()), h.pop();
+        bench::row("8-ary build + pops", bench::elapsed_ms(st), got == ref, 32);
+    }
+    {
+        auto st = chrono::steady_clock::now();
+        DaryHeap<ULL, 8> h;
+        h.build(w.init.begin(), w.init.end());
+        got.clear();
+        h.pop_many(n0 / 4, back_inserter(got));
+        bool ok = got == ref && h.size() == (size_t)(n0 - n0 / 4) && h.top() >= ref.back();
+        bench::row("8-ary build + pop_many", bench::elapsed_ms(st), ok, 32);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n0 = argc >= 3 ? atoi(argv[2]) : 4000000;
+        int m = argc >= 4 ? atoi(argv[3]) : 10000000;
+        benchmark(n0, m);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // AcWing 838: 输入 5 3 / 4 5 1 3 2，输出 1 2 3
+    int n, m;
+    if (!(cin >> n >> m)) return 0;
+    vector<int> a(n);
+    for (auto& x : a) cin >> x;
+    DaryHeap<int, 8> h;
+    h.build(a.begin(), a.end());
+    vector<int> out;
+    h.pop_many(m, back_inserter(out));
+    for (int x : out) cout << x << " ";
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,462 @@
+/*
+ * ============================================
+ *   LRU / LFU 缓存 - 数组双链表 + 拉链哈希，构造之后零分配
+ *   基于 02_double_linked_list.cpp (add / remove) / 11_hash_table.cpp (h[], ne[] 拉链)
+ *   题目来源: LeetCode 146. LRU 缓存 / LeetCode 460. LFU 缓存
+ * ============================================
+ *
+ * 【问题】
+ *   容量固定为 C 的缓存，get(k) / put(k, v) 都要 O(1)；满了以后 put 新键要先淘汰一个：
+ *   - LRU：淘汰最久没被访问的；
+ *   - LFU：淘汰访问次数最少的，次数相同时淘汰其中最久没被访问的。
+ *
+ * 【LRU = 双链表 + 哈希表】
+ *   双链表按访问时间排队，和 02 一样 0、1 两个哨兵，数据槽位从 2 开始：
+ *
+ *     [0] <==> [最近访问] <==> ... <==> [最久没访问] <==> [1]
+ *
+ *   - 命中：remove(s) 再 add(0, s)，挪到最前面；
+ *   - 淘汰：l[1] 就是最久没访问的，它的槽位直接给新键用。
+ *   哈希表就是 11 的拉链法：h[桶] 是链头，槽位 s 本身当链表节点 (ne[s] 是桶链里的下一个)，
+ *   所以键 -> 槽位不需要额外的节点，淘汰时从桶链里摘掉即可。
+ *
+ * 【LFU = 频次链表套元素链表】
+ *   每个出现过的访问次数 c 对应一个"频次节点"，频次节点按 c 从小到大串成一条双链表；
+ *   每个频次节点下面再挂一条元素双链表 (最近访问的在前)：
+ *
+ *     [哨兵] <==> (c=1) <==> (c=3) <==> (c=7) <==> [哨兵]
+ *                   |          |          |
+ *                 A, D         B          C          <- 各自按最近访问排
+ *
+ *   - 命中 x (次数 c -> c+1)：看右边的频次节点是不是 c+1，不是就新建一个插在右边，
+ *     把 x 挪过去；原来的频次节点空了就删掉。频次节点只会和左右邻居打交道，O(1)；
+ *   - 淘汰：最左边的频次节点 (次数最少) 的元素链表的尾巴 (其中最久没访问的)；
+ *   - 新键：次数为 1，挂到最左边的 c=1 节点 (没有就新建)。
+ *   频次节点最多 C + 1 个 (C 个元素各占一个，再加命中时临时新建的一个)，也在构造时一次开好。
+ *
+ * 【零分配】
+ *   所有数组在构造时按容量开好，之后 get / put / erase 只改下标；
+ *   删掉的槽位 / 频次节点挂在空闲链上 (复用 r[] / ne[] / fn[] 当 next)，不会像原版 idx 一样只增不减。
+ *
+ * 【统计】
+ *   Stats 记录 get 次数、命中数、put 次数、淘汰数，给出命中率和从 reset 起算的每秒操作数。
+ *
+ * 【复杂度】
+ *   - get / put / erase：O(1) (哈希期望 O(1))
+ *   - 空间：LRU 每个槽位 2 个 LL + 3 个 int；LFU 再加每个频次节点 1 个 LL + 4 个 int
+ *
+ * 【用法】
+ *   ./a.out [lru|lfu]          读入 C m 和 m 个操作 (get k / put k v)，每个 get 输出值 (没有输出 -1)
+ *   ./a.out bench [键数] [访问数] [容量] [zipf 参数]
+ *   编译: g++ -std=c++17 -O2 14_lru_lfu_cache.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 统计 ==========
+struct Stats {
+    LL gets = 0, hits = 0, puts = 0, evictions = 0;
+    chrono::steady_clock::time_point since = chrono::steady_clock::now();
+
+    void reset() { *this = Stats(); }
+    double hit_rate() const { return gets ? (double)hits / gets : 0; }
+    double ops_per_sec() const {
+        double sec = chrono::duration<double>(chrono::steady_clock::now() - since).count();
+        return sec > 0 ? (gets + puts) / sec : 0;
+    }
+};
+
+// ========== 键 -> 槽位：11_hash_table 的拉链法，槽位本身当链表节点 ==========
+struct SlotHash {
+    vector<int> h, ne; // h[桶] = 链头槽位，ne[槽位] = 桶链里的下一个
+    const vector<LL>* key = nullptr;
+    int shift = 0;
+
+    void init(int slots, const vector<LL>& keys) {
+        int cap = 2;
+        while (cap < slots) cap *= 2; // 负载因子 <= 1
+        h.assign(cap, -1);
+        ne.assign(slots, -1);
+        shift = 64 - __builtin_ctz(cap);
+        key = &keys;
+    }
+
+    // Fibonacci 哈希：乘黄金比例常数取高位
+    int bucket(LL k) const { return (int)((uint64_t)k * 0x9E3779B97F4A7C15ull >> shift); }
+
+    int find(LL k) const {
+        for (int i = h[bucket(k)]; i != -1; i = ne[i])
+            if ((*key)[i] == k) return i;
+        return -1;
+    }
+    void insert(int s) {
+        int b = bucket((*key)[s]);
+        ne[s] = h[b];
+        h[b] = s;
+    }
+    void erase(int s) {
+        int* p = &h[bucket((*key)[s])];
+        while (*p != s) p = &ne[*p];
+        *p = ne[s];
+    }
+};
+
+// ========== LRU ==========
+struct LRUCache {
+    int cap, idx = 2, free_head = -1, n = 0;
+    vector<LL> key, val;
+    vector<int> l, r; // 02 的双链表，0 / 1 是哨兵
+    SlotHash ht;
+    Stats stats;
+
+    explicit LRUCache(int capacity) : cap(capacity), key(capacity + 2), val(capacity + 2), l(capacity + 2), r(capacity + 2) {
+        r[0] = 1, l[1] = 0;
+        ht.init(capacity + 2, key);
+    }
+
+    // 02 原样：把 s 插到 k 的右边 / 把 s 摘掉
+    void add(int k, int s) {
+        l[s] = k, r[s] = r[k];
+        l[r[k]] = s, r[k] = s;
+    }
+    void remove(int s) {
+        r[l[s]] = r[s];
+        l[r[s]] = l[s];
+    }
+
+    int size() const { return n; }
+
+    bool get(LL k, LL& v) {
+        stats.gets++;
+        int s = ht.find(k);
+        if (s < 0) return false;
+        stats.hits++;
+        remove(s), add(0, s);
+        v = val[s];
+        return true;
+    }
+
+    void put(LL k, LL v) {
+        stats.puts++;
+        int s = ht.find(k);
+        if (s >= 0) {
+            val[s] = v;
+            remove(s), add(0, s);
+            return;
+        }
+        if (cap == 0) return;
+        if (free_head != -1) s = free_head, free_head = r[s];
+        else if (idx < cap + 2) s = idx++;
+        else { // 满了：淘汰最久没访问的，槽位直接复用
+            s = l[1];
+            remove(s), ht.erase(s);
+            stats.evictions++, n--;
+        }
+        key[s] = k, val[s] = v;
+        ht.insert(s), add(0, s);
+        n++;
+    }
+
+    bool erase(LL k) {
+        int s = ht.find(k);
+        if (s < 0) return false;
+        remove(s), ht.erase(s);
+        r[s] = free_head, free_head = s;
+        n--;
+        return true;
+    }
+};
+
+// ========== LFU ==========
+struct LFUCache {
+    int cap, idx = 0, free_item = -1, free_freq = -1, n = 0;
+    // 元素槽位 0 .. cap-1：键、值、所在频次节点、元素链表的前后
+    vector<LL> key, val;
+    vector<int> fq, pr, ne;
+    // 频次节点 1 .. cap+1 (0 是哨兵)：访问次数、频次链表的前后、元素链表的头尾
+    vector<LL> cnt;
+    vector<int> fp, fn, head, tail;
+    SlotHash ht;
+    Stats stats;
+
+    explicit LFUCache(int capacity)
+        : cap(capacity), key(capacity), val(capacity), fq(capacity), pr(capacity), ne(capacity), cnt(capacity + 2),
+          fp(capacity + 2), fn(capacity + 2), head(capacity + 2, -1), tail(capacity + 2, -1) {
+        fn[0] = fp[0] = 0;
+        for (int f = 1; f < capacity + 2; f++) fn[f] = free_freq, free_freq = f;
+        ht.init(capacity, key);
+    }
+
+    // 元素链表：挂到频次节点 f 的最前面 / 从自己的频次节点上摘下来
+    void push_front(int f, int s) {
+        fq[s] = f, pr[s] = -1, ne[s] = head[f];
+        if (head[f] != -1) pr[head[f]] = s;
+        else tail[f] = s;
+        head[f] = s;
+    }
+    void unlink(int s) {
+        int f = fq[s];
+        if (pr[s] != -1) ne[pr[s]] = ne[s];
+        else head[f] = ne[s];
+        if (ne[s] != -1) pr[ne[s]] = pr[s];
+        else tail[f] = pr[s];
+    }
+
+    // 频次链表：在 p 右边新建次数为 c 的节点 / 删掉空了的节点
+    int new_freq_after(int p, LL c) {
+        int f = free_freq;
+        free_freq = fn[f];
+        cnt[f] = c, head[f] = tail[f] = -1;
+        fp[f] = p, fn[f] = fn[p];
+        fp[fn[p]] = f, fn[p] = f;
+        return f;
+    }
+    void drop_freq_if_empty(int f) {
+        if (head[f] != -1) return;
+        fn[fp[f]] = fn[f], fp[fn[f]] = fp[f];
+        fn[f] = free_freq, free_freq = f;
+    }
+
+    // 访问一次：挪到次数 + 1 的频次节点
+    void touch(int s) {
+        int f = fq[s], g = fn[f];
+        if (g == 0 || cnt[g] != cnt[f] + 1) g = new_freq_after(f, cnt[f] + 1);
+        unlink(s), push_front(g, s);
+        drop_freq_if_empty(f);
+    }
+
+    int size() const { return n; }
+
+    bool get(LL k, LL& v) {
+        stats.gets++;
+        int s = ht.find(k);
+        if (s < 0) return false;
+        stats.hits++;
+        touch(s);
+        v = val[s];
+        return true;
+    }
+
+    void put(LL k, LL v) {
+        stats.puts++;
+        int s = ht.find(k);
+        if (s >= 0) {
+            val[s] = v;
+            touch(s);
+            return;
+        }
+        if (cap == 0) return;
+        if (free_item != -1) s = free_item, free_item = ne[s];
+        else if (idx < cap) s = idx++;
+        else { // 满了：次数最少的频次节点里最久没访问的
+            int f = fn[0];
+            s = tail[f];
+            unlink(s), ht.erase(s);
+            drop_freq_if_empty(f);
+            stats.evictions++, n--;
+        }
+        key[s] = k, val[s] = v;
+        ht.insert(s);
+        int f = fn[0];
+        if (f == 0 || cnt[f] != 1) f = new_freq_after(0, 1);
+        push_front(f, s);
+        n++;
+    }
+
+    bool erase(LL k) {
+        int s = ht.find(k);
+        if (s < 0) return false;
+        int f = fq[s];
+        unlink(s), ht.erase(s);
+        drop_freq_if_empty(f);
+        ne[s] = free_item, free_item = s;
+        n--;
+        return true;
+    }
+};
+
+// ========== 基准测试 ==========
+// 对照组：教科书写法 std::list + unordered_map (每个新键都要 new 节点)
+struct StdLRU {
+    int cap;
+    list<pair<LL, LL>> q;
+    unordered_map<LL, list<pair<LL, LL>>::iterator> pos;
+    LL hits = 0;
+    explicit StdLRU(int c) : cap(c) {}
+    bool get(LL k, LL& v) {
+        auto it = pos.find(k);
+        if (it == pos.end()) return false;
+        q.splice(q.begin(), q, it->second);
+        v = it->second->second;
+        hits++;
+        return true;
+    }
+    void put(LL k, LL v) {
+        auto it = pos.find(k);
+        if (it != pos.end()) {
+            it->second->second = v;
+            q.splice(q.begin(), q, it->second);
+            return;
+        }
+        if (cap == 0) return;
+        if ((int)q.size() == cap) pos.erase(q.back().first), q.pop_back();
+        q.emplace_front(k, v);
+        pos[k] = q.begin();
+    }
+};
+
+struct StdLFU {
+    struct Item {
+        LL v, c;
+        list<LL>::iterator it;
+    };
+    int cap;
+    LL min_c = 0, hits = 0;
+    unordered_map<LL, Item> items;
+    unordered_map<LL, list<LL>> by_c; // 次数 -> 键 (最近访问的在前)
+    explicit StdLFU(int c) : cap(c) {}
+    void touch(Item& x, LL k) {
+        auto& old = by_c[x.c];
+        old.erase(x.it);
+        if (old.empty()) {
+            by_c.erase(x.c);
+            if (min_c == x.c) min_c++;
+        }
+        x.c++;
+        auto& now = by_c[x.c];
+        now.push_front(k);
+        x.it = now.begin();
+    }
+    bool get(LL k, LL& v) {
+        auto it = items.find(k);
+        if (it == items.end()) return false;
+        touch(it->second, k);
+        v = it->second.v;
+        hits++;
+        return true;
+    }
+    void put(LL k, LL v) {
+        auto it = items.find(k);
+        if (it != items.end()) {
+            it->second.v = v;
+            touch(it->second, k);
+            return;
+        }
+        if (cap == 0) return;
+        if ((int)items.size() == cap) {
+            auto& lst = by_c[min_c];
+            items.erase(lst.back());
+            lst.pop_back();
+            if (lst.empty()) by_c.erase(min_c);
+        }
+        auto& one = by_c[1];
+        one.push_front(k);
+        items[k] = {v, 1, one.begin()};
+        min_c = 1;
+    }
+};
+
+void benchmark(int U, int T, int C, double s) {
+    // Zipf(s)：第 i 热的键概率 ∝ 1 / i^s，累积分布上二分采样；键本身随机打散成 64 位
+    mt19937_64 rng(20260118);
+    vector<double> cdf(U);
+    double acc = 0;
+    for (int i = 0; i < U; i++) cdf[i] = acc += 1 / pow(i + 1.0, s);
+    vector<LL> ids(U);
+    for (auto& x : ids) x = (LL)(rng() >> 1);
+    vector<LL> trace(T);
+    uniform_real_distribution<double> u01(0, acc);
+    for (auto& k : trace) k = ids[lower_bound(cdf.begin(), cdf.end(), u01(rng)) - cdf.begin()];
+    printf("zipf(%.2f) over %d keys, %d accesses, capacity %d\n", s, U, T, C);
+
+    auto replay = [&](auto& cache) {
+        LL v;
+        for (LL k : trace)
+            if (!cache.get(k, v)) cache.put(k, k ^ 0x5bd1e995);
+    };
+    auto row = [&](const char* name, double ms, LL hits, const char* mark) { // 操作数 = T 次 get + 未命中的 put
+        printf("  %-30s %9.1f ms  %7.2f Mops/s  hit %.4f%s\n", name, ms, (2.0 * T - hits) / ms / 1e3, (double)hits / T,
+               mark);
+    };
+
+    LL lru_hits, lfu_hits;
+    {
+        StdLRU c(C);
+        auto st = chrono::steady_clock::now();
+        replay(c);
+        row("std::list + unordered_map LRU", bench::elapsed_ms(st), lru_hits = c.hits, "");
+    }
+    {
+        LRUCache c(C);
+        auto st = chrono::steady_clock::now();
+        replay(c);
+        double ms = bench::elapsed_ms(st);
+        printf("  %-30s %9.1f ms  %7.2f Mops/s  hit %.4f  evictions %lld%s\n", "array LRU", ms,
+               c.stats.ops_per_sec() / 1e6, c.stats.hit_rate(), c.stats.evictions,
+               bench::check(c.stats.hits == lru_hits));
+    }
+    {
+        StdLFU c(C);
+        auto st = chrono::steady_clock::now();
+        replay(c);
+        row("std containers LFU", bench::elapsed_ms(st), lfu_hits = c.hits, "");
+    }
+    {
+        LFUCache c(C);
+        auto st = chrono::steady_clock::now();
+        replay(c);
+        double ms = bench::elapsed_ms(st);
+        printf("  %-30s %9.1f ms  %7.2f Mops/s  hit %.4f  evictions %lld%s\n", "array LFU", ms,
+               c.stats.ops_per_sec() / 1e6, c.stats.hit_rate(), c.stats.evictions,
+               bench::check(c.stats.hits == lfu_hits));
+    }
+}
+
+template <class Cache>
+void run_ops(int C, int m) {
+    Cache c(C);
+    while (m--) {
+        string op;
+        LL k, v;
+        cin >> op >> k;
+        if (op == "get") cout << (c.get(k, v) ? v : -1) << "\n";
+        else cin >> v, c.put(k, v);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int U = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int T = argc >= 4 ? atoi(argv[3]) : 10000000;
+        int C = argc >= 5 ? atoi(argv[4]) : 100000;
+        double s = argc >= 6 ? atof(argv[5]) : 0.99;
+        benchmark(U, T, C, s);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // 输入 2 9 / put 1 1 / put 2 2 / get 1 / put 3 3 / get 2 / put 4 4 / get 1 / get 3 / get 4
+    // LRU 输出 1 -1 -1 3 4；LFU 输出 1 -1 1 -1 4
+    int C, m;
+    if (!(cin >> C >> m)) return 0;
+    if (argc >= 2 && strcmp(argv[1], "lfu") == 0) run_ops<LFUCache>(C, m);
+    else run_ops<LRUCache>(C, m);
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+ * ============================================
+ *   AC 自动机 (Aho-Corasick) - Trie + 失配指针 + 稠密转移表 + 流式匹配
+ *   基于 08_trie.cpp (son[][], idx) / 07_kmp.cpp (ne[] 失配回退)
+ *   题目来源: AcWing 1282. 搜索关键词
+ * ============================================
+ *
+ * 【为什么不能一个模式串跑一遍 KMP】
+ *   5 万个特征串、1GB 日志：KMP 每个模式串都要把日志完整扫一遍，就是 5 万遍。
+ *   AC 自动机把所有模式串放进一棵 Trie，日志只扫一遍，每个字符 O(1) 转移。
+ *
+ * 【Trie 上的 KMP】
+ *   KMP 的 ne[j]：已经匹配了 p[1..j]，失配后退到"p[1..j] 最长的、也是 p 前缀的真后缀"。
+ *   AC 自动机的 ne[u]：Trie 节点 u 代表字符串 S(u)，ne[u] 是"S(u) 最长的、
+ *   也是某个模式串前缀 (= 某个 Trie 节点) 的真后缀"。一条链变成了一棵树。
+ *   和 KMP 的 ne[i] 由 ne[i-1] 推出一样，按 BFS 层序求 (父节点的 ne 已经求好)：
+ *     ne[son[p][c]] = son[ne[p]][c]    (ne[p] 那边没有 c 就继续往 ne 上退)
+ *
+ * 【稠密转移表 (goto 表)：把"往 ne 上退"预先算好】
+ *   BFS 时顺手把 son[p][c] 的空位补上：son[p][c] = son[ne[p]][c]。
+ *   于是匹配时不再有 while (j && ...) j = ne[j]，每个字符恰好一次查表：
+ *     p = son[p][c];
+ *   这就是 08 的 son[N][26]，只是空位从 0 改成了"失配后应该去的节点"。
+ *
+ * 【字母表压缩 + 状态编号预乘】
+ *   日志是任意字节，开 256 列太浪费。只给模式串里出现过的字节编号 1..K，
+ *   其余字节都归到 0 号 (它们在任何状态都直接回根)。列数取 >= K+1 的 2 的幂 W，
+ *   状态直接存"节点号 * W"，转移就是 son[p + c]，省掉每个字符一次乘法。
+ *   256 个字节全用上时 K = 256，编号要 9 位 (cls 是 uint16_t)，W = 512。
+ *   预乘后的状态是 int，节点数 x W 超过 INT_MAX 时 build 抛 length_error。
+ *
+ * 【输出】
+ *   走到节点 u 时，S(u) 的每个后缀里是模式串的都匹配上了：沿 ne 往上找。
+ *   为了不在 ne 链上白走，预先求"输出链" dict[u] = ne 链上第一个有模式串结尾的节点，
+ *   一个位置的每个匹配只花 O(1)。同一个模式串出现多次 (重复添加) 挂在 same[] 链上。
+ *
+ * 【流式 feed(chunk)】
+ *   自动机只读；匹配状态 (当前节点 + 已经读了多少字节) 放在单独的 Stream 里，
+ *   日志一块一块喂进去，跨块的匹配照样能找到，报告 (模式串编号, 结束位置)：
+ *   结束位置 = 匹配的最后一个字节在整个流里的下标 + 1。
+ *
+ * 【复杂度】
+ *   - 构建：O(总长度 * W)
+ *   - 匹配：O(文本长度 + 匹配数)
+ *   - 空间：goto 表 节点数 x W 个 int (5 万个长 ~12 的小写串约 50 万节点 x 32 列 = 64MB)
+ *
+ * 【用法】
+ *   ./a.out                          AcWing 1282：T 组，每组 n、n 个关键词、一篇文章，输出出现过的关键词个数
+ *   ./a.out grep <模式串文件>         每行一个模式串，stdin 分块流式匹配，输出 "编号 结束位置"
+ *   ./a.out bench [模式串数] [文本 MB]
+ *   编译: g++ -std=c++17 -O2 15_aho_corasick.cpp
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 自动机 ==========
+struct AhoCorasick {
+    vector<string> pats;
+    int W = 1, shift = 0;   // goto 表的列数 (2 的幂) 和 log2
+    uint16_t cls[256] = {0}; // 字节 -> 列号 1..256，0 = 没在模式串里出现过
+    vector<int> son;        // son[p + c]：p 是预乘过 W 的状态
+    vector<int> ne;         // 失配指针 (按节点号)
+    vector<int> term;       // 以该节点结尾的第一个模式串，-1 表示没有
+    vector<int> dict;       // 输出链：ne 链上下一个有模式串结尾的节点，0 表示没有
+    vector<int> outn;       // 走到该节点时第一个要报告的节点 (自己或 dict)，0 表示不用报告
+    vector<int> same;       // 和模式串 id 完全相同的下一个模式串
+    int idx = 0;            // 最大的节点号 (0 是根)
+
+    // 先把模式串都收下来，build 时再统一建 (要先知道字母表)；返回模式串编号
+    int add(const string& s) {
+        pats.push_back(s);
+        return pats.size() - 1;
+    }
+
+    void build() {
+        // 1. 字母表压缩
+        memset(cls, 0, sizeof cls);
+        int K = 0;
+        for (auto& s : pats)
+            for (unsigned char ch : s)
+                if (!cls[ch]) cls[ch] = ++K;
+        W = 1, shift = 0;
+        while (W < K + 1) W <<= 1, shift++;
+
+        // 2. 08 的 insert，只是 son 换成一维、节点号预乘 W；新节点用到时才给它开一行
+        son.assign(W, 0);
+        term.assign(1, -1);
+        same.assign(pats.size(), -1);
+        idx = 0;
+        for (int id = 0; id < (int)pats.size(); id++) {
+            if (pats[id].empty()) continue; // 空串不参与匹配
+            int p = 0;
+            for (unsigned char ch : pats[id]) {
+                int nx = son[p + cls[ch]];
+                if (!nx) {
+                    if ((LL)(idx + 2) * W > INT_MAX) throw length_error("AhoCorasick: goto table exceeds int states");
+                    nx = son[p + cls[ch]] = ++idx << shift;
+                    son.resize(son.size() + W, 0);
+                    term.push_back(-1);
+                }
+                p = nx;
+            }
+            int u = p >> shift;
+            same[id] = term[u], term[u] = id;
+        }
+
+        // 3. 按 BFS 层序重新编号：插入顺序下浅层节点散在整张表里，
+        //    而匹配时绝大多数时间都停在前几层，排在一起才能常驻缓存
+        {
+            vector<int> q(idx + 1), id(idx + 1);
+            int hh = 0, tt = 0;
+            q[0] = 0;
+            while (hh <= tt) {
+                int u = q[hh], p = u << shift;
+                id[u] = hh++;
+                for (int c = 0; c < W; c++)
+                    if (son[p + c]) q[++tt] = son[p + c] >> shift;
+            }
+            vector<int> son2(son.size()), term2(idx + 1);
+            for (int i = 0; i <= idx; i++) {
+                int u = q[i];
+                for (int c = 0; c < W; c++) {
+                    int nx = son[(u << shift) + c];
+                    son2[(i << shift) + c] = nx ? id[nx >> shift] << shift : 0;
+                }
+                term2[i] = term[u];
+            }
+            son.swap(son2), term.swap(term2);
+        }
+
+        // 4. BFS 求 ne / dict，同时把 son 的空位补成失配后的去处
+        ne.assign(idx + 1, 0);
+        dict.assign(idx + 1, 0);
+        outn.assign(idx + 1, 0);
+        vector<int> q(idx + 1);
+        int hh = 0, tt = -1;
+        for (int c = 0; c < W; c++)
+            if (son[c]) q[++tt] = son[c] >> shift; // 第一层的 ne 都是根
+        while (hh <= tt) {
+            int u = q[hh++], p = u << shift;
+            int f = ne[u];
+            dict[u] = term[f] != -1 ? f : dict[f];
+            outn[u] = term[u] != -1 ? u : dict[u];
+            for (int c = 0; c < W; c++) {
+                int& nx = son[p + c];
+                if (nx) {
+                    ne[nx >> shift] = son[(f << shift) + c] >> shift;
+                    q[++tt] = nx >> shift;
+                } else {
+                    nx = son[(f << shift) + c];
+                }
+            }
+        }
+        // 根的空位本来就是 0 (回根)，不用补
+    }
+
+    // 流式匹配状态：同一个自动机可以同时给多条流用
+    struct Stream {
+        const AhoCorasick* ac;
+        int p = 0;   // 当前状态 (预乘过 W)
+        LL pos = 0;  // 已经读过的字节数
+
+        explicit Stream(const AhoCorasick& a) : ac(&a) {}
+
+        // 喂一块数据，每个匹配调用 report(模式串编号, 结束位置)
+        template <class Report>
+        void feed(const char* s, size_t n, Report&& report) {
+            const int* son = ac->son.data();
+            const int* outn = ac->outn.data();
+            const uint16_t* cls = ac->cls;
+            int p = this->p, sh = ac->shift;
+            for (size_t i = 0; i < n; i++) {
+                p = son[p + cls[(unsigned char)s[i]]];
+                int u = outn[p >> sh];
+                if (__builtin_expect(u != 0, 0)) {
+                    for (; u; u = ac->dict[u])
+                        for (int id = ac->term[u]; id != -1; id = ac->same[id]) report(id, pos + i + 1);
+                }
+            }
+            this->p = p, pos += n;
+        }
+        template <class Report>
+        void feed(const string& s, Report&& report) { feed(s.data(), s.size(), report); }
+    };
+};
+
+// ========== 基准测试 ==========
+// 07 的 KMP (对照组)：下标从 1 开始，返回所有匹配结束位置之和 (校验用) 并计数
+LL kmp_scan(const string& pat, const string& text, LL& cnt) {
+    int n = pat.size(), m = text.size();
+    const char* p = pat.data() - 1;
+    const char* s = text.data() - 1;
+    vector<int> ne(n + 1, 0);
+    for (int i = 2, j = 0; i <= n; i++) {
+        while (j && p[i] != p[j + 1]) j = ne[j];
+        if (p[i] == p[j + 1]) j++;
+        ne[i] = j;
+    }
+    LL sum = 0;
+    for (int i = 1, j = 0; i <= m; i++) {
+        while (j && s[i] != p[j + 1]) j = ne[j];
+        if (s[i] == p[j + 1]) j++;
+        if (j == n) {
+            sum += i, cnt++;
+            j = ne[j];
+        }
+    }
+    return sum;
+}
+
+void benchmark(int P, int mb) {
+    mt19937 rng(20260120);
+    AhoCorasick ac;
+    vector<string> pats(P);
+    for (auto& s : pats) {
+        int len = 6 + rng() % 11;
+        for (int i = 0; i < len; i++) s += char('a' + rng() % 26);
+        ac.add(s);
+    }
+    // 日志：随机小写字母和空格，每 ~200 字节埋一个特征串
+    string text;
+    text.reserve((size_t)mb << 20);
+    while (text.size() < ((size_t)mb << 20)) {
+        if (rng() % 200 == 0) text += pats[rng() % P];
+        else text += rng() % 6 ? char('a' + rng() % 26) : ' ';
+    }
+    printf("%d patterns, %.1f MB text\n", P, text.size() / 1048576.0);
+
+    auto st = chrono::steady_clock::now();
+    ac.build();
+    double t_build = bench::elapsed_ms(st);
+    printf("  %-34s %9.1f ms  (%d nodes x %d columns = %.1f MB)\n", "build automaton", t_build, ac.idx + 1, ac.W,
+           ac.son.size() * 4.0 / 1048576);
+
+    // 一次喂完
+    vector<LL> cnt(P, 0), sum(P, 0);
+    st = chrono::steady_clock::now();
+    AhoCorasick::Stream one(ac);
+    LL matches = 0;
+    one.feed(text, [&](int id, LL end) { cnt[id]++, sum[id] += end, matches++; });
+    double t_ac = bench::elapsed_ms(st);
+    printf("  %-34s %9.1f ms  (%lld matches, %.0f MB/s)\n", "aho-corasick, one feed", t_ac, matches,
+           text.size() / 1048576.0 / t_ac * 1e3);
+
+    // 随机大小分块喂，结果必须一样
+    vector<LL> cnt2(P, 0), sum2(P, 0);
+    st = chrono::steady_clock::now();
+    AhoCorasick::Stream chunked(ac);
+    for (size_t i = 0; i < text.size();) {
+        size_t len = min(text.size() - i, (size_t)(1 + rng() % 65536));
+        chunked.feed(text.data() + i, len, [&](int id, LL end) { cnt2[id]++, sum2[id] += end; });
+        i += len;
+    }
+    double t_chunk = bench::elapsed_ms(st);
+    bench::row("aho-corasick, random chunks", t_chunk, cnt2 == cnt && sum2 == sum);
+
+    // KMP 逐个模式串扫：只抽 S 个，按比例估算全部
+    int S = min(P, 20);
+    bool ok = true;
+    st = chrono::steady_clock::now();
+    for (int id = 0; id < S; id++) {
+        LL c = 0, s = kmp_scan(pats[id], text, c);
+        // 重复的模式串各自都会被 AC 报告，KMP 也各自扫到，所以逐个比较即可
+        ok &= c == cnt[id] && s == sum[id];
+    }
+    double t_kmp = bench::elapsed_ms(st);
+    printf("  %-34s %9.1f ms  (measured on %d patterns)%s\n", "KMP per pattern, estimated", t_kmp * P / S, S,
+           bench::check(ok));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int P = argc >= 3 ? atoi(argv[2]) : 50000;
+        int mb = argc >= 4 ? atoi(argv[3]) : 64;
+        benchmark(P, mb);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    if (argc >= 3 && strcmp(argv[1], "grep") == 0) {
+        AhoCorasick ac;
+        ifstream fin(argv[2]);
+        string line;
+        while (getline(fin, line)) ac.add(line);
+        ac.build();
+        AhoCorasick::Stream st(ac);
+        vector<char> buf(1 << 16);
+        for (;;) {
+            cin.read(buf.data(), buf.size());
+            size_t got = cin.gcount();
+            if (!got) break;
+            st.feed(buf.data(), got, [&](int id, LL end) { cout << id << " " << end << "\n"; });
+        }
+        return 0;
+    }
+
+    // AcWing 1282: 输入 1 / 5 / she / he / say / shr / her / yasherhs，输出 3
+    int T;
+    if (!(cin >> T)) return 0;
+    while (T--) {
+        int n;
+        cin >> n;
+        AhoCorasick ac;
+        for (int i = 0; i < n; i++) {
+            string s;
+            cin >> s;
+            ac.add(s);
+        }
+        string text;
+        cin >> text;
+        ac.build();
+        vector<char> seen(n, 0);
+        int ans = 0;
+        AhoCorasick::Stream st(ac);
+        st.feed(text, [&](int id, LL) { ans += !seen[id], seen[id] = 1; });
+        cout << ans << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,258 @@
+/*
+ * ============================================
+ *   可撤销并查集 + 线段树分治 (离线动态图连通性)
+ *   基于 09_union_find.cpp (p[] 父节点数组)
+ *   题目来源: LOJ 121. 「离线可过」动态图连通性
+ * ============================================
+ *
+ * 【原版只能加边】
+ *   09 / 13_kruskal / ex05 里的并查集都是"只合并、不拆开"：路径压缩把树拍扁之后，
+ *   原来是哪条边把谁连起来的已经无从知道，删一条边只能从头重建，每次询问 O(n + m)。
+ *
+ * 【可撤销并查集：不压缩路径 + 按大小合并 + 撤销栈】
+ *   - 不做路径压缩：一次合并只改一个 p[] (小树的根挂到大树的根下) 和一个 sz[]；
+ *   - 按大小合并保证树高 <= log n，所以 find 不压缩也是 O(log n)；
+ *   - 每次合并把"被挂上去的根"压栈；撤销就是弹栈，把它的 p[] 改回自己、sz[] 减回去。
+ *   只能按后进先出撤销 (和栈一样)，正好配合下面的递归。
+ *
+ * 【线段树分治：把"删边"变成"撤销"】
+ *   离线把时间轴按询问编号切成 0..q-1，每条边存活的时间是一段区间 [l, r)：
+ *
+ *     时间(询问)   0   1   2   3   4   5
+ *     边 (1,2)     [=======)                  加在询问 0 前，删在询问 2 前
+ *     边 (2,3)             [===========)
+ *
+ *   把 [l, r) 挂到线段树上 O(log q) 个节点 (和区间修改一样拆)，
+ *   然后 DFS 整棵树：进入节点时把挂在上面的边都 unite，到叶子回答那个询问，
+ *   离开节点时撤销回进来时的栈高度。叶子 t 看到的恰好是 t 时刻存活的所有边。
+ *   每个节点上挂的边用 h[], eu[], ev[], ne[] 邻接表存 (和图论里存边一样)。
+ *
+ * 【复杂度】
+ *   - 每条边挂到 O(log q) 个节点，每次 unite / find O(log n)
+ *   - 总计 O((n + m) + (m log q + q) log n)，m 是加边次数
+ *   - 空间：O(n + m log q)
+ *
+ * 【用法】
+ *   ./a.out                        LOJ 121：n m，m 行 "op x y"，op = 0 加边 / 1 删边 / 2 询问，输出 Y / N
+ *   ./a.out bench [n] [操作数]
+ *   编译: g++ -std=c++17 -O2 16_dsu_rollback_dynamic_connectivity.cpp
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include "../bench.h"
+
+using namespace std;
+
+typedef long long LL;
+
+// ========== 可撤销并查集 ==========
+struct RollbackDSU {
+    vector<int> p, sz;
+    vector<int> stk; // 每次合并时被挂上去的根
+    int comps;       // 当前连通块个数
+
+    explicit RollbackDSU(int n) : p(n), sz(n, 1), comps(n) {
+        for (int i = 0; i < n; i++) p[i] = i;
+    }
+
+    // 不压缩：树高 <= log n
+    int find(int x) const {
+        while (p[x] != x) x = p[x];
+        return x;
+    }
+
+    bool unite(int a, int b) {
+        a = find(a), b = find(b);
+        if (a == b) return false;
+        if (sz[a] > sz[b]) swap(a, b);
+        p[a] = b, sz[b] += sz[a], comps--;
+        stk.push_back(a);
+        return true;
+    }
+
+    int snapshot() const { return stk.size(); }
+
+    // 撤销到 snapshot() 返回的栈高度
+    void rollback(int to) {
+        while ((int)stk.size() > to) {
+            int a = stk.back();
+            stk.pop_back();
+            sz[p[a]] -= sz[a], p[a] = a, comps++;
+        }
+    }
+};
+
+// ========== 离线动态连通性 ==========
+struct DynamicConnectivity {
+    struct Op {
+        int type, u, v; // 0 加边 / 1 删边 / 2 询问
+    };
+
+    int n;
+    vector<Op> ops;
+
+    explicit DynamicConnectivity(int n) : n(n) {}
+    void add_edge(int u, int v) { ops.push_back({0, u, v}); }
+    void remove_edge(int u, int v) { ops.push_back({1, u, v}); }
+    void query(int u, int v) { ops.push_back({2, u, v}); }
+
+    // 线段树节点上挂的边：h[node] -> 邻接表；qs[t] 是第 t 个询问
+    vector<int> h, eu, ev, ne;
+    vector<pair<int, int>> qs;
+
+    void attach(int u, int l, int r, int L, int R, int a, int b) {
+        if (L <= l && r <= R) {
+            eu.push_back(a), ev.push_back(b), ne.push_back(h[u]), h[u] = eu.size() - 1;
+            return;
+        }
+        int mid = (l + r) >> 1;
+        if (L < mid) attach(u << 1, l, mid, L, R, a, b);
+        if (R > mid) attach(u << 1 | 1, mid, r, L, R, a, b);
+    }
+
+    void dfs(int u, int l, int r, RollbackDSU& d, vector<char>& ans) {
+        int snap = d.snapshot();
+        for (int i = h[u]; i != -1; i = ne[i]) d.unite(eu[i], ev[i]);
+        if (r - l == 1) {
+            ans[l] = d.find(qs[l].first) == d.find(qs[l].second);
+        } else {
+            int mid = (l + r) >> 1;
+            dfs(u << 1, l, mid, d, ans);
+            dfs(u << 1 | 1, mid, r, d, ans);
+        }
+        d.rollback(snap);
+    }
+
+    // 按询问的先后顺序返回答案：1 连通 / 0 不连通
+    vector<char> solve() {
+        qs.clear();
+        for (auto& o : ops)
+            if (o.type == 2) qs.push_back({o.u, o.v});
+        int q = qs.size();
+        vector<char> ans(q);
+        if (!q) return ans;
+
+        h.assign(4 * q, -1), eu.clear(), ev.clear(), ne.clear();
+        // 每条边 (无向，小号在前) 的每次加入开一段区间，删除时关掉最近开的那段
+        map<pair<int, int>, vector<int>> open;
+        int t = 0;
+        for (auto& o : ops) {
+            if (o.type == 2) {
+                t++;
+                continue;
+            }
+            auto key = minmax(o.u, o.v);
+            if (o.type == 0) {
+                open[key].push_back(t);
+            } else {
+                auto it = open.find(key);
+                if (it == open.end() || it->second.empty()) continue; // 删不存在的边：忽略
+                int l = it->second.back();
+                it->second.pop_back();
+                if (l < t) attach(1, 0, q, l, t, key.first, key.second);
+            }
+        }
+        for (auto& [key, starts] : open)
+            for (int l : starts)
+                if (l < q) attach(1, 0, q, l, q, key.first, key.second);
+
+        RollbackDSU d(n);
+        dfs(1, 0, q, d, ans);
+        return ans;
+    }
+};
+
+// ========== 基准测试 ==========
+void benchmark(int n, int m) {
+    mt19937 rng(20260124);
+    DynamicConnectivity dc(n);
+    // 操作流：加边多于删边，让图慢慢连起来又被拆开；删边只删当前存在的边
+    vector<pair<int, int>> alive;
+    int q = 0;
+    for (int i = 0; i < m; i++) {
+        int r = rng() % 10;
+        if (r < 4 || alive.empty()) {
+            int u = rng() % n, v = rng() % n;
+            alive.push_back({u, v});
+            dc.add_edge(u, v);
+        } else if (r < 7) {
+            int k = rng() % alive.size();
+            swap(alive[k], alive.back());
+            dc.remove_edge(alive.back().first, alive.back().second);
+            alive.pop_back();
+        } else {
+            dc.query(rng() % n, rng() % n);
+            q++;
+        }
+    }
+    printf("n = %d, %d operations (%d queries)\n", n, m, q);
+
+    auto st = chrono::steady_clock::now();
+    vector<char> ans = dc.solve();
+    double t1 = bench::elapsed_ms(st);
+    LL yes = count(ans.begin(), ans.end(), 1);
+    printf("  %-36s %9.1f ms  (%lld Y)\n", "rollback DSU + segment tree on time", t1, yes);
+
+    // 朴素做法 (对照组)：每个询问用 09 的并查集把当前存活的边从头合并一遍。
+    // 全做一遍太慢，抽 S 个询问计时 (存活边集合顺着操作流维护，不计时)，按比例估算
+    int S = min(q, 200), k = 0, next = 0;
+    bool ok = true;
+    double t0 = 0;
+    map<pair<int, int>, int> cnt;
+    vector<int> p(n);
+    auto find = [&](int x) {
+        while (p[x] != x) x = p[x] = p[p[x]];
+        return x;
+    };
+    for (auto& o : dc.ops) {
+        if (o.type == 0) {
+            cnt[minmax(o.u, o.v)]++;
+        } else if (o.type == 1) {
+            if (--cnt[minmax(o.u, o.v)] == 0) cnt.erase(minmax(o.u, o.v));
+        } else {
+            if (k == (LL)next * q / S) {
+                st = chrono::steady_clock::now();
+                for (int i = 0; i < n; i++) p[i] = i;
+                for (auto& [e, c] : cnt) p[find(e.first)] = find(e.second);
+                ok &= (find(o.u) == find(o.v)) == (bool)ans[k];
+                t0 += bench::elapsed_ms(st);
+                next++;
+            }
+            k++;
+        }
+    }
+    printf("  %-36s %9.1f ms  (measured on %d queries)%s\n", "rebuild per query, estimated", t0 * q / S, S,
+           bench::check(ok));
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 100000;
+        int m = argc >= 4 ? atoi(argv[3]) : 1000000;
+        benchmark(n, m);
+        return 0;
+    }
+
+    ios::sync_with_stdio(false);
+    cin.tie(0);
+
+    // LOJ 121: 输入 3 6 / 0 1 2 / 2 1 3 / 0 2 3 / 2 1 3 / 1 1 2 / 2 1 3，输出 N / Y / N
+    int n, m;
+    if (!(cin >> n >> m)) return 0;
+    DynamicConnectivity dc(n + 1);
+    while (m--) {
+        int op, x, y;
+        cin >> op >> x >> y;
+        if (op == 0) dc.add_edge(x, y);
+        else if (op == 1) dc.remove_edge(x, y);
+        else dc.query(x, y);
+    }
+    for (char a : dc.solve()) cout << (a ? "Y" : "N") << "\n";
+    return 0;
+}
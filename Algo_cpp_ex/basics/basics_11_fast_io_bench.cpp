@@ -0,0 +1,133 @@
+/**
+ * ============================================================
+ * 竞赛基础 11：fast_io.h 和 iostream 读写 10^7 个整数的对比
+ * ============================================================
+ * 学习目标：
+ * 1. 看清 basics_01 里的 cin / cout (已经关了同步) 在大输入下到底花多少时间
+ * 2. 对比 ../fast_io.h：mmap 零拷贝 + 8 字节一起解析，输出两位一组 + 大缓冲
+ * 3. 看 stdin 是普通文件 (mmap) 和管道 (分块 read) 两种情况的差别
+ *
+ * 用法：
+ *   ./a.out [n] [临时文件]      默认 n = 10^7，文件 /tmp/fast_io_bench.txt
+ *   编译: g++ -std=c++17 -O2 basics_11_fast_io_bench.cpp
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <fcntl.h>
+#include "../fast_io.h"
+#include "../bench.h"
+using namespace std;
+
+typedef long long LL;
+
+int main(int argc, char** argv) {
+    int n = argc >= 2 ? atoi(argv[1]) : 10000000;
+    string path = argc >= 3 ? argv[2] : "/tmp/fast_io_bench.txt";
+
+    // ---------------------------------------------------------
+    // 1. 造数据：第一行 n，然后 n 个 [-10^9, 10^9] 的整数，每行 10 个
+    // ---------------------------------------------------------
+    mt19937 rng(20260116);
+    vector<int> a(n);
+    LL expect = 0;
+    for (auto& x : a) x = (int)(rng() % 2000000001u) - 1000000000, expect += x;
+    {
+        FILE* f = fopen(path.c_str(), "w");
+        if (!f) return printf("cannot write %s\n", path.c_str()), 1;
+        fprintf(f, "%d\n", n);
+        for (int i = 0; i < n; i++) fprintf(f, "%d%c", a[i], i % 10 == 9 ? '\n' : ' ');
+        fclose(f);
+    }
+    printf("%d integers in %s\n", n, path.c_str());
+
+    // ---------------------------------------------------------
+    // 2. 读：每种方式都把 n 个数加起来，和 expect 对一下
+    // ---------------------------------------------------------
+    auto report = [&](const char* name, double ms, LL sum) {
+        bench::row(name, ms, sum == expect);
+    };
+    {
+        auto st = chrono::steady_clock::now();
+        ifstream fin(path); // 和关了同步的 cin 走同一套 num_get
+        int m, x;
+        LL sum = 0;
+        fin >> m;
+        for (int i = 0; i < m; i++) fin >> x, sum += x;
+        report("read: iostream >>", bench::elapsed_ms(st), sum);
+    }
+    {
+        auto st = chrono::steady_clock::now();
+        int fd = open(path.c_str(), O_RDONLY);
+        LL sum = 0;
+        {
+            fastio::Reader in(fd); // 普通文件：mmap
+            int m, x;
+            in >> m;
+            for (int i = 0; i < m; i++) in >> x, sum += x;
+        }
+        close(fd);
+        report("read: fast_io (file, mmap)", bench::elapsed_ms(st), sum);
+    }
+    {
+        auto st = chrono::steady_clock::now();
+        FILE* pipe = popen(("cat " + path).c_str(), "r");
+        LL sum = 0;
+        {
+            fastio::Reader in(fileno(pipe)); // 管道：分块 read
+            int m, x;
+            in >> m;
+            for (int i = 0; i < m; i++) in >> x, sum += x;
+        }
+        pclose(pipe);
+        report("read: fast_io (pipe, 1MB blocks)", bench::elapsed_ms(st), sum);
+    }
+
+    // ---------------------------------------------------------
+    // 3. 写：n 个数每个一行，写到 /dev/null 计时；再各写一份小文件比对内容
+    // ---------------------------------------------------------
+    {
+        auto st = chrono::steady_clock::now();
+        ofstream fout("/dev/null");
+        for (int x : a) fout << x << '\n';
+        fout.flush();
+        bench::row("write: iostream <<", bench::elapsed_ms(st));
+    }
+    {
+        auto st = chrono::steady_clock::now();
+        int fd = open("/dev/null", O_WRONLY);
+        {
+            fastio::Writer out(fd);
+            for (int x : a) out << x << '\n';
+        }
+        close(fd);
+        double ms = bench::elapsed_ms(st);
+
+        string p1 = path + ".ios", p2 = path + ".fast";
+        int k = min(n, 1000000);
+        {
+            ofstream fout(p1);
+            for (int i = 0; i < k; i++) fout << a[i] << ' ' << (LL)a[i] * a[i] << '\n';
+        }
+        {
+            int fd2 = open(p2.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            fastio::Writer out(fd2);
+            for (int i = 0; i < k; i++) out << a[i] << ' ' << (LL)a[i] * a[i] << '\n';
+            out.flush();
+            close(fd2);
+        }
+        ifstream f1(p1), f2(p2);
+        string s1((istreambuf_iterator<char>(f1)), istreambuf_iterator<char>());
+        string s2((istreambuf_iterator<char>(f2)), istreambuf_iterator<char>());
+        bench::row("write: fast_io (1MB buffer)", ms, s1 == s2);
+        remove(p1.c_str()), remove(p2.c_str());
+    }
+
+    remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * ============================================
+ *   bench.h - 各题 bench 模式共用的计时 + 校验输出
+ *   和 fast_io.h / loser_tree.h 一样放在 Algo_cpp_ex/ 下，#include "../bench.h"
+ * ============================================
+ *
+ * 【约定】
+ *   每个 bench 都是"对照组 (原版) vs 新写法"，新写法的结果必须和对照组一模一样：
+ *   一致时只印耗时，不一致就在行尾标 "<-- WRONG!"，一眼就能看出哪一行错了。
+ *
+ * 【用法】
+ *   auto st = chrono::steady_clock::now();
+ *   ...;
+ *   double t = bench::elapsed_ms(st);
+ *   bench::row("new version", t, got == ref);              // "  new version   12.3 ms"
+ *   printf("  %-30s %9.1f ms  (%d items)%s\n", name, t, n, bench::check(ok));  // 自己排版时只拿后缀
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// 从 st 到现在过了多少毫秒
+inline double elapsed_ms(std::chrono::steady_clock::time_point st) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - st).count();
+}
+
+// 结果校验的行尾标记：对了是空串
+inline const char* check(bool ok) { return ok ? "" : "  <-- WRONG!"; }
+
+// 最常见的一行："  名字 (左对齐 width 列)  耗时 ms" + 校验标记
+inline void row(const char* name, double ms, bool ok = true, int width = 34) {
+    printf("  %-*s %9.1f ms%s\n", width, name, ms, check(ok));
+}
+
+} // namespace bench
@@ -0,0 +1,281 @@
+/*
+ * ============================================
+ *   fast_io.h - mmap 零拷贝读整数 + 大缓冲写 (所有题解可共用)
+ *   对照 basics/basics_01_io.cpp (cin / cout + sync_with_stdio(false))
+ *   基准测试: basics/basics_11_fast_io_bench.cpp
+ * ============================================
+ *
+ * 【cin 慢在哪】
+ *   关了同步之后 cin >> x 每次仍然要：构造 sentry、查 locale 的 ctype / num_get、
+ *   一个字符一个字符地经过 streambuf 虚函数接口，再做溢出检查。
+ *   10^7 个数光读入就要 1 秒上下，比很多题的算法本身还慢。
+ *
+ * 【读：整个文件映射进内存】
+ *   stdin 是普通文件 (./a.out < in.txt) 时 mmap 整个文件，直接在页缓存上解析，不拷贝；
+ *   是管道 / 终端 (cat in.txt | ./a.out) 时没法 mmap，退回 1MB 缓冲 + read()，
+ *   每次只 read() 一回，拿到多少算多少，不等整块填满 (交互 / 流式输入不会卡住)；
+ *   缓冲里剩的不够 64 字节、又还没看到数的结尾 (空白) 时，把尾巴挪到开头接着读，
+ *   保证一个数不会被块边界切开。
+ *
+ * 【解析：一次看 8 个字符 (SWAR)】
+ *   把 8 个字节当一个 uint64 读进来 (小端：第一个字符在最低字节)：
+ *   1. 数出开头连着几个数字：字节是数字 <=> 高半字节是 3 且 +6 后高半字节还是 3，
+ *      第一个不是数字的字节用 ctz 找到 (它之后的字节算错了也没关系)；
+ *   2. 减去 '0'，左移把非数字的部分挤出去 (低位补 0，相当于前导零)；
+ *   3. 相邻两位合并、再相邻两组合并，3 次乘法把 8 位数字变成整数：
+ *        "12345678" -> 12 34 56 78 -> 1234 5678 -> 12345678
+ *   不足 8 字节的文件末尾退回逐字符。整个数只有"够不够 8 位"这一个分支。
+ *
+ * 【写：两位两位地出】
+ *   100 个两位数 "00" ~ "99" 预先排成一张 200 字节的表，每次除以 100 写两个字符，
+ *   除法次数减半；输出先攒进 1MB 的缓冲，满了 (或析构时) 一次 write()。
+ *
+ * 【用法】
+ *   #include "../fast_io.h"
+ *   fastio::Reader in;          // 默认读 stdin，也可以传入文件描述符
+ *   fastio::Writer out;         // 默认写 stdout，析构时自动刷新
+ *   int n; LL x;
+ *   while (in >> n >> x) out << n + x << '\n';
+ *
+ *   ⚠️ 和 basics_01 里"不要混用 cin 和 scanf"一样：用了 Reader 就别再用 cin 读，
+ *      用了 Writer 就别再用 cout / printf 写 (或者先 out.flush())。
+ *   只依赖 POSIX (mmap / read / write)，Linux / macOS 都能用。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fastio {
+
+// ========== 读 ==========
+class Reader {
+public:
+    explicit Reader(int fd = 0) : fd(fd) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            off_t pos = lseek(fd, 0, SEEK_CUR); // 前面可能已经读掉了一部分
+            void* m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED && pos >= 0 && pos <= st.st_size) {
+                madvise(m, st.st_size, MADV_SEQUENTIAL);
+                map = (char*)m, map_len = st.st_size;
+                p = map + pos, end = map + map_len;
+                eof = true; // 整个文件都在内存里了，不用再 read
+                return;
+            }
+            if (m != MAP_FAILED) munmap(m, st.st_size);
+        }
+        buf = new char[BLOCK];
+        p = end = buf;
+    }
+    ~Reader() {
+        if (map) munmap(map, map_len);
+        delete[] buf;
+    }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // 读一个整数 (可带 '-')，没有了或者不是数字返回 false
+    template <class T>
+    bool read_int(T& x) {
+        if (!skip_space()) return false;
+        while (!eof && end - p < KEEP && !has_space()) refill();
+        bool neg = *p == '-';
+        p += neg;
+        const char* start = p;
+        uint64_t v = 0;
+        while (end - p >= 8) {
+            uint64_t chunk;
+            memcpy(&chunk, p, 8);
+            uint64_t bad = ((chunk & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull) |
+                           (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull);
+            int len = bad ? __builtin_ctzll(bad) >> 3 : 8;
+            if (len == 0) break;
+            v = v * POW10[len] + parse8((chunk - 0x3030303030303030ull) << (64 - 8 * len));
+            p += len;
+            if (len < 8) goto done;
+        }
+        while (p < end && (unsigned)(*p - '0') < 10) v = v * 10 + (*p++ - '0'); // 文件末尾不足 8 字节
+    done:
+        if (p == start) return false;
+        x = neg ? (T)(0 - v) : (T)v;
+        return true;
+    }
+
+    // 读一个非空白字符
+    bool read_char(char& c) {
+        if (!skip_space()) return false;
+        c = *p++;
+        return true;
+    }
+
+    // 读一个不含空白的单词
+    bool read_word(std::string& s) {
+        if (!skip_space()) return false;
+        s.clear();
+        for (;;) {
+            const char* q = p;
+            while (q < end && (unsigned char)*q > ' ') q++;
+            s.append(p, q);
+            p = q;
+            if (p < end || eof) return true;
+            refill(); // 单词可能跨块
+            if (p == end) return true;
+        }
+    }
+
+    template <class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
+    Reader& operator>>(T& x) {
+        ok = ok && read_int(x);
+        return *this;
+    }
+    Reader& operator>>(char& c) {
+        ok = ok && read_char(c);
+        return *this;
+    }
+    Reader& operator>>(std::string& s) {
+        ok = ok && read_word(s);
+        return *this;
+    }
+    explicit operator bool() const { return ok; } // while (in >> x) 的写法
+
+private:
+    static const int BLOCK = 1 << 20;
+    static const int KEEP = 64; // 剩余不足这么多字节、又没看到空白就接着读，保证整数不会被块边界切开
+    static constexpr uint64_t POW10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+    int fd;
+    char* map = nullptr;
+    size_t map_len = 0;
+    char* buf = nullptr;
+    const char* p = nullptr;
+    const char* end = nullptr;
+    bool eof = false, ok = true;
+
+    // 8 个 0~9 的字节 (第一个字符在最低字节) -> 十进制整数
+    static uint64_t parse8(uint64_t v) {
+        v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFull;
+        v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFull;
+        return (v * 10000 + (v >> 32)) & 0xFFFFFFFFull;
+    }
+
+    // 未读部分挪到开头，再 read() 一次：管道上有多少先拿多少，不等缓冲读满
+    void refill() {
+        size_t rest = end - p;
+        memmove(buf, p, rest);
+        p = buf, end = buf + rest;
+        ssize_t got = read(fd, (char*)end, buf + BLOCK - end);
+        if (got <= 0) eof = true;
+        else end += got;
+    }
+
+    // 剩下的字节里有没有空白：有就说明当前这个数已经完整在缓冲里了
+    bool has_space() const {
+        for (const char* q = p; q < end; q++)
+            if ((unsigned char)*q <= ' ') return true;
+        return false;
+    }
+
+    // 跳过空白，停在下一个记号的开头；没有了返回 false
+    bool skip_space() {
+        for (;;) {
+            while (p < end && (unsigned char)*p <= ' ') p++;
+            if (p < end) return true;
+            if (eof) return false;
+            refill();
+        }
+    }
+};
+
+// ========== 写 ==========
+class Writer {
+public:
+    explicit Writer(int fd = 1) : fd(fd), buf(new char[BLOCK]) {}
+    ~Writer() {
+        flush();
+        delete[] buf;
+    }
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    void flush() {
+        for (const char* q = buf; q < buf + len;) {
+            ssize_t put = write(fd, q, buf + len - q);
+            if (put <= 0) break;
+            q += put;
+        }
+        len = 0;
+    }
+
+    template <class T>
+    void write_int(T x) {
+        if (len > BLOCK - 24) flush();
+        typedef typename std::make_unsigned<T>::type U;
+        U v = x;
+        if (x < 0) buf[len++] = '-', v = 0 - v;
+        char tmp[24];
+        char* q = tmp + sizeof tmp;
+        while (v >= 100) {
+            q -= 2;
+            memcpy(q, DIGITS + v % 100 * 2, 2);
+            v /= 100;
+        }
+        if (v >= 10) q -= 2, memcpy(q, DIGITS + v * 2, 2);
+        else *--q = char('0' + v);
+        memcpy(buf + len, q, tmp + sizeof tmp - q);
+        len += tmp + sizeof tmp - q;
+    }
+
+    void write_bytes(const char* s, size_t n) {
+        if (len + n > (size_t)BLOCK) {
+            flush();
+            if (n > (size_t)BLOCK) { // 太长的直接写，不经过缓冲
+                for (size_t put = 0; put < n;) {
+                    ssize_t w = write(fd, s + put, n - put);
+                    if (w <= 0) return;
+                    put += w;
+                }
+                return;
+            }
+        }
+        memcpy(buf + len, s, n);
+        len += n;
+    }
+
+    template <class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
+    Writer& operator<<(T x) {
+        write_int(x);
+        return *this;
+    }
+    Writer& operator<<(char c) {
+        if (len == BLOCK) flush();
+        buf[len++] = c;
+        return *this;
+    }
+    Writer& operator<<(const char* s) {
+        write_bytes(s, strlen(s));
+        return *this;
+    }
+    Writer& operator<<(const std::string& s) {
+        write_bytes(s.data(), s.size());
+        return *this;
+    }
+
+private:
+    static const int BLOCK = 1 << 20;
+    static constexpr char DIGITS[201] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                        "8081828384858687888990919293949596979899";
+
+    int fd;
+    char* buf;
+    int len = 0;
+};
+
+} // namespace fastio
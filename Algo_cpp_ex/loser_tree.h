@@ -0,0 +1,157 @@
+/*
+ * ============================================
+ *   loser_tree.h - 流式败者树 k 路归并 + 块读写的有序段 (外存归并共用)
+ *   原理和基准测试: acwing_01_basics/22_heap_sequence_merge_loser_tree.cpp
+ *   使用者: 22 的外部排序、21_interval_merge_external.cpp 的区间 run 归并
+ * ============================================
+ *
+ * 【内容】
+ *   - LoserTree<T, Source, Cmp>：k 个 Source 的队首站在叶子上，内部结点存败者 (值 + 路号)，
+ *     pop 一次沿一条路径重赛，ceil(log k) 次比较；取完的路一律算输，不需要 +∞ 哨兵；
+ *     值相同时路号小的赢 (稳定)。
+ *   - Source 只要求 bool next(T& x)：
+ *       RangeSource<It>  内存里的有序段 [first, last)
+ *       FileRun<T>       磁盘上的有序段，按块 fread
+ *   - FileWriter<T>：按块 fwrite，写失败后 ok 变 false。
+ *
+ * 【用法】
+ *   #include "../loser_tree.h"
+ *   vector<kway::FileRun<int>> src;        // 每个有序段一个
+ *   kway::LoserTree<int, kway::FileRun<int>> lt(src);
+ *   int x;
+ *   while (lt.pop(x)) ...                  // 按全局顺序取出
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace kway {
+
+// ========== 败者树 ==========
+template <class T, class Source, class Cmp = std::less<T>>
+struct LoserTree {
+    // 结点里直接存败者的值：重赛时顺序读一条路径，不用再按路号去 cur[] 里查
+    struct Node {
+        T v;
+        int s;      // 来自第几路
+        bool alive; // 这一路还有没有数 (false 时 v 无意义)
+    };
+
+    int k = 0;
+    std::vector<Source>* src = nullptr;
+    std::vector<Node> tree; // tree[0] 冠军，tree[1..k-1] 败者
+    Cmp cmp;
+
+    LoserTree(std::vector<Source>& s, Cmp c = Cmp()) : cmp(c) { init(s); }
+
+    // a 能不能赢 b：取完的算输，值相同路号小的赢
+    bool beats(const Node& a, const Node& b) const {
+        if (!b.alive) return a.alive || a.s < b.s;
+        if (!a.alive) return false;
+        if (cmp(a.v, b.v)) return true;
+        if (cmp(b.v, a.v)) return false;
+        return a.s < b.s;
+    }
+
+    void init(std::vector<Source>& s) {
+        src = &s;
+        k = s.size();
+        tree.assign(std::max(k, 1), Node{T(), 0, false});
+        if (k) tree[0] = build(1);
+    }
+
+    // 结点 p 以下比一轮，败者留在 tree[p]，返回胜者
+    Node build(int p) {
+        if (p >= k) {
+            Node leaf{T(), p - k, false};
+            leaf.alive = (*src)[p - k].next(leaf.v);
+            return leaf;
+        }
+        Node a = build(2 * p), b = build(2 * p + 1);
+        if (beats(a, b)) {
+            tree[p] = std::move(b);
+            return a;
+        }
+        tree[p] = std::move(a);
+        return b;
+    }
+
+    bool empty() const { return k == 0 || !tree[0].alive; }
+    const T& top() const { return tree[0].v; }
+    int top_source() const { return tree[0].s; }
+
+    // 取走冠军，它那一路补位，沿路径重赛
+    bool pop(T& out) {
+        if (empty()) return false;
+        Node w = std::move(tree[0]);
+        out = std::move(w.v);
+        w.alive = (*src)[w.s].next(w.v);
+        for (int p = (w.s + k) >> 1; p >= 1; p >>= 1)
+            if (beats(tree[p], w)) std::swap(tree[p], w);
+        tree[0] = std::move(w);
+        return true;
+    }
+};
+
+// ========== 数据源 ==========
+
+// 内存里的有序段 [first, last)
+template <class It>
+struct RangeSource {
+    It first, last;
+    template <class T>
+    bool next(T& x) {
+        if (first == last) return false;
+        x = *first++;
+        return true;
+    }
+};
+
+// 磁盘上的有序段：按块读进缓冲区 (fread 出错和读完一样返回 false，调用方用 ferror 区分)
+template <class T>
+struct FileRun {
+    FILE* f = nullptr;
+    std::vector<T> buf;
+    size_t pos = 0, len = 0;
+
+    FileRun(FILE* f_, size_t block) : f(f_), buf(std::max<size_t>(block, 1)) {}
+
+    bool next(T& x) {
+        if (pos == len) {
+            len = fread(buf.data(), sizeof(T), buf.size(), f);
+            pos = 0;
+            if (len == 0) return false;
+        }
+        x = buf[pos++];
+        return true;
+    }
+};
+
+// 带缓冲的二进制写出；写不进去 (磁盘满 / 短写) 时 ok 变 false，之后的数据直接丢弃
+template <class T>
+struct FileWriter {
+    FILE* f;
+    std::vector<T> buf;
+    size_t len = 0;
+    bool ok = true;
+
+    FileWriter(FILE* f_, size_t block) : f(f_), buf(std::max<size_t>(block, 1)) {}
+    ~FileWriter() { flush(); }
+
+    void put(const T& x) {
+        buf[len++] = x;
+        if (len == buf.size()) flush();
+    }
+    bool flush() {
+        if (len && ok && fwrite(buf.data(), sizeof(T), len, f) != len) ok = false;
+        len = 0;
+        return ok;
+    }
+};
+
+} // namespace kway